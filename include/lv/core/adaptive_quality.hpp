@@ -0,0 +1,282 @@
+#pragma once
+
+/**
+ * @file adaptive_quality.hpp
+ * @brief Lower rendering quality under overload, restore it with headroom
+ *
+ * AdaptiveQuality measures the render time of every refresh that renders
+ * something (the sum of its `LV_EVENT_RENDER_START` to `LV_EVENT_RENDER_READY`
+ * spans, so flushing and waiting for vsync don't count) against a frame
+ * budget. After `degrade_after` frames over budget it steps one quality level
+ * down; after `restore_after` frames under `headroom_pct` of the budget it
+ * steps back up:
+ *
+ * | Level | Effect |
+ * |-------|--------|
+ * | Quality::full | Everything as styled |
+ * | Quality::no_effects | Box shadows skipped, gradients drawn as their mid color |
+ * | Quality::low_vector | + vector paths drawn at LV_VECTOR_PATH_QUALITY_LOW |
+ * | Quality::half_rate | + display refreshed at half rate: animations skip every other frame |
+ *
+ * @code
+ * lv::AdaptiveQuality quality(display, {.budget_ms = 16});
+ * quality.on_change([](lv::Quality q) { lottie.set_fps(q >= lv::Quality::half_rate ? 30 : 60); });
+ * @endcode
+ *
+ * Effects are applied to draw tasks before a draw unit takes them, by
+ * wrapping every draw unit's dispatch_cb (like RenderThreads: create it
+ * after, destroy it before). Only one AdaptiveQuality should exist at a
+ * time. Restoring quality invalidates the screen.
+ */
+
+#include <lvgl.h>
+#include <src/core/lv_global.h>          // Draw unit list
+#include <src/draw/lv_draw_private.h>    // lv_draw_task_t, lv_draw_unit_t, lv_layer_t
+#include <src/misc/lv_timer_private.h>   // Refresh timer period
+#if LV_USE_VECTOR_GRAPHIC
+#include <src/draw/lv_draw_vector_private.h>   // Vector task list and paths
+#endif
+#include "function.hpp"
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace lv {
+
+/// Rendering quality levels, from best to cheapest
+enum class Quality : uint8_t {
+    full,
+    no_effects,
+    low_vector,
+    half_rate,
+};
+
+/// AdaptiveQuality options
+struct QualityConfig {
+    uint32_t budget_ms = 0;          ///< Frame budget (0 = the display's refresh period)
+    uint32_t headroom_pct = 60;      ///< Restore below this share of the budget
+    uint32_t degrade_after = 2;      ///< Consecutive frames over budget before stepping down
+    uint32_t restore_after = 30;     ///< Consecutive frames with headroom before stepping up
+    Quality min_quality = Quality::half_rate;   ///< Lowest level to go to
+};
+
+namespace detail {
+
+struct QualityUnitSlot {
+    lv_draw_unit_t* unit = nullptr;
+    int32_t (*original)(lv_draw_unit_t*, lv_layer_t*) = nullptr;
+};
+
+inline constexpr uint32_t QUALITY_MAX_UNITS = 8;
+inline QualityUnitSlot g_quality_units[QUALITY_MAX_UNITS] = {};
+inline uint32_t g_quality_unit_count = 0;
+inline Quality g_quality = Quality::full;
+
+/// Cheapen the tasks of a layer that no unit has taken yet
+inline void degrade_tasks(lv_layer_t* layer) noexcept {
+    for (lv_draw_task_t* t = layer->draw_task_head; t; t = t->next) {
+        if (t->state != LV_DRAW_TASK_STATE_QUEUED && t->state != LV_DRAW_TASK_STATE_WAITING) continue;
+        switch (t->type) {
+        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+            t->state = LV_DRAW_TASK_STATE_READY;   // Removed by the dispatcher without drawing
+            break;
+        case LV_DRAW_TASK_TYPE_FILL: {
+            auto* dsc = static_cast<lv_draw_fill_dsc_t*>(t->draw_dsc);
+            if (dsc->grad.dir != LV_GRAD_DIR_NONE && dsc->grad.stops_count > 0) {
+                dsc->color = lv_color_mix(dsc->grad.stops[0].color,
+                                          dsc->grad.stops[dsc->grad.stops_count - 1].color, LV_OPA_50);
+                dsc->grad.dir = LV_GRAD_DIR_NONE;
+            }
+            break;
+        }
+#if LV_USE_VECTOR_GRAPHIC
+        case LV_DRAW_TASK_TYPE_VECTOR: {
+            if (g_quality < Quality::low_vector) break;
+            auto* dsc = static_cast<lv_draw_vector_task_dsc_t*>(t->draw_dsc);
+            lv_ll_t* list = dsc->task_list;
+            if (!list) break;
+            for (void* n = lv_ll_get_head(list); n; n = lv_ll_get_next(list, n)) {
+                auto* vt = static_cast<lv_vector_draw_task*>(n);
+                if (vt->path) vt->path->quality = LV_VECTOR_PATH_QUALITY_LOW;
+            }
+            break;
+        }
+#endif
+        default:
+            break;
+        }
+    }
+}
+
+inline int32_t quality_dispatch(lv_draw_unit_t* unit, lv_layer_t* layer) {
+    for (uint32_t i = 0; i < g_quality_unit_count; ++i) {
+        if (g_quality_units[i].unit != unit) continue;
+        if (g_quality != Quality::full) degrade_tasks(layer);
+        return g_quality_units[i].original(unit, layer);
+    }
+    return LV_DRAW_UNIT_IDLE;
+}
+
+} // namespace detail
+
+/**
+ * @brief Render-time driven quality controller for one display
+ *
+ * Non-movable (registered as display event callback with `this` as user
+ * data). Destroy before the display is deleted.
+ */
+class AdaptiveQuality {
+    using Clock = std::chrono::steady_clock;
+
+    lv_display_t* m_display = nullptr;
+    QualityConfig m_cfg;
+    uint32_t m_period = LV_DEF_REFR_PERIOD;   ///< Refresh period at full quality
+    uint32_t m_over = 0;
+    uint32_t m_under = 0;
+    bool m_rendering = false;
+    Clock::time_point m_start{};       ///< Of the area being rendered
+    uint64_t m_frame_us = 0;           ///< Render time of the frame so far
+    uint32_t m_last_us = 0;
+    uint32_t m_changes = 0;
+    InplaceFunction<void(Quality)> m_on_change;
+
+    static void event_cb(lv_event_t* e) {
+        auto* self = static_cast<AdaptiveQuality*>(lv_event_get_user_data(e));
+        switch (lv_event_get_code(e)) {
+        case LV_EVENT_REFR_START:
+            self->m_frame_us = 0;
+            self->m_rendering = false;
+            break;
+        case LV_EVENT_RENDER_START:
+            self->m_start = Clock::now();
+            self->m_rendering = true;
+            break;
+        case LV_EVENT_RENDER_READY:
+            self->m_frame_us += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - self->m_start).count());
+            break;
+        case LV_EVENT_REFR_READY:
+            if (self->m_rendering) self->on_frame();
+            break;
+        default:
+            break;
+        }
+    }
+
+    void on_frame() noexcept {
+        m_last_us = static_cast<uint32_t>(m_frame_us);
+        const uint64_t budget_us = static_cast<uint64_t>(m_cfg.budget_ms) * 1000;
+
+        if (m_last_us > budget_us) {
+            m_under = 0;
+            if (++m_over >= m_cfg.degrade_after && detail::g_quality < m_cfg.min_quality) {
+                set(static_cast<Quality>(static_cast<uint8_t>(detail::g_quality) + 1));
+            }
+        } else if (m_last_us * 100 < budget_us * m_cfg.headroom_pct) {
+            m_over = 0;
+            if (++m_under >= m_cfg.restore_after && detail::g_quality != Quality::full) {
+                set(static_cast<Quality>(static_cast<uint8_t>(detail::g_quality) - 1));
+            }
+        } else {
+            m_over = 0;
+            m_under = 0;
+        }
+    }
+
+    void set(Quality q) noexcept {
+        const Quality prev = detail::g_quality;
+        detail::g_quality = q;
+        m_over = 0;
+        m_under = 0;
+        ++m_changes;
+
+        if (lv_timer_t* timer = lv_display_get_refr_timer(m_display)) {
+            lv_timer_set_period(timer, q >= Quality::half_rate ? m_period * 2 : m_period);
+        }
+        // Shadows, gradients and paths come back only where redrawn
+        if (q < prev && prev >= Quality::no_effects) {
+            lv_obj_invalidate(lv_display_get_screen_active(m_display));
+            lv_obj_invalidate(lv_display_get_layer_top(m_display));
+        }
+        if (m_on_change) m_on_change(q);
+    }
+
+public:
+    /**
+     * @brief Start controlling a display's quality
+     *
+     * @param display Display to watch (nullptr = default display)
+     * @param cfg Budget and hysteresis
+     */
+    explicit AdaptiveQuality(lv_display_t* display = nullptr, const QualityConfig& cfg = {}) noexcept
+        : m_cfg(cfg) {
+        if (!display) display = lv_display_get_default();
+        if (!display) return;
+        m_display = display;
+        if (lv_timer_t* timer = lv_display_get_refr_timer(display)) m_period = timer->period;
+        if (m_cfg.budget_ms == 0) m_cfg.budget_ms = m_period;
+        if (m_cfg.degrade_after == 0) m_cfg.degrade_after = 1;
+        if (m_cfg.restore_after == 0) m_cfg.restore_after = 1;
+
+        lv_display_add_event_cb(display, &event_cb, LV_EVENT_REFR_START, this);
+        lv_display_add_event_cb(display, &event_cb, LV_EVENT_RENDER_START, this);
+        lv_display_add_event_cb(display, &event_cb, LV_EVENT_RENDER_READY, this);
+        lv_display_add_event_cb(display, &event_cb, LV_EVENT_REFR_READY, this);
+
+        detail::g_quality = Quality::full;
+        detail::g_quality_unit_count = 0;
+        for (lv_draw_unit_t* u = LV_GLOBAL_DEFAULT()->draw_info.unit_head; u; u = u->next) {
+            if (detail::g_quality_unit_count == detail::QUALITY_MAX_UNITS) break;
+            detail::QualityUnitSlot& s = detail::g_quality_units[detail::g_quality_unit_count++];
+            s.unit = u;
+            s.original = u->dispatch_cb;
+            u->dispatch_cb = &detail::quality_dispatch;
+        }
+    }
+
+    /// Restore full quality, the refresh rate and the draw units
+    ~AdaptiveQuality() {
+        if (!m_display) return;
+        if (detail::g_quality != Quality::full) set(Quality::full);
+        lv_display_remove_event_cb_with_user_data(m_display, &event_cb, this);
+        for (uint32_t i = 0; i < detail::g_quality_unit_count; ++i) {
+            detail::g_quality_units[i].unit->dispatch_cb = detail::g_quality_units[i].original;
+        }
+        detail::g_quality_unit_count = 0;
+    }
+
+    AdaptiveQuality(const AdaptiveQuality&) = delete;
+    AdaptiveQuality& operator=(const AdaptiveQuality&) = delete;
+
+    /// Current quality level
+    [[nodiscard]] Quality quality() const noexcept { return detail::g_quality; }
+
+    /// Force a level (the controller keeps adapting from there)
+    AdaptiveQuality& quality(Quality q) noexcept {
+        if (m_display && q != detail::g_quality) set(q);
+        return *this;
+    }
+
+    /// Call fn with the new level whenever it changes
+    template<typename F>
+    AdaptiveQuality& on_change(F&& fn) noexcept {
+        m_on_change = std::forward<F>(fn);
+        return *this;
+    }
+
+    /// Render time of the last rendered frame in µs
+    [[nodiscard]] uint32_t last_render_us() const noexcept { return m_last_us; }
+
+    /// Number of level changes so far
+    [[nodiscard]] uint32_t changes() const noexcept { return m_changes; }
+
+    /// Print the current state with LV_LOG_USER
+    void log() const noexcept {
+        [[maybe_unused]] static constexpr const char* names[] = {"full", "no_effects", "low_vector", "half_rate"};
+        LV_LOG_USER("AdaptiveQuality: %s, last frame %uus of %ums budget, %u changes",
+                    names[static_cast<uint8_t>(detail::g_quality)], static_cast<unsigned>(m_last_us),
+                    static_cast<unsigned>(m_cfg.budget_ms), static_cast<unsigned>(m_changes));
+    }
+};
+
+} // namespace lv
@@ -0,0 +1,276 @@
+#pragma once
+
+/**
+ * @file async_flush.hpp
+ * @brief Display flush on a dedicated thread with triple buffering
+ *
+ * Normally a display's flush_cb runs inside lv_timer_handler(): while a
+ * frame is copied to scanout (fbdev, DRM), nothing is rendered. AsyncFlush
+ * moves the backend's flush_cb to a flush thread and gives LVGL three
+ * draw buffers that rotate:
+ *
+ * - LVGL renders into one buffer
+ * - The flush thread sends another to the backend
+ * - The third is queued (or free), so rendering continues at once
+ *
+ * LVGL only waits when both other buffers are still queued for the flush
+ * thread, i.e. when scanout is slower than rendering.
+ *
+ * @code
+ * lv::FBDisplay display;                                // Copy mode (partial)
+ * lv::AsyncFlush async(display);                        // 1/10 screen chunks
+ * lv::AsyncFlush async(display, LV_DISPLAY_RENDER_MODE_FULL);
+ * // ...
+ * async.log();
+ * @endcode
+ *
+ * Only copy backends are supported: the backend receives AsyncFlush's own
+ * RAM buffers and must copy (or send) the pixels. Zero-copy backends, whose
+ * flush_cb expects px_map to be one of their scanout buffers (FBDisplay in
+ * pan mode, DRMDisplay), are refused: they are recognized by their two
+ * direct/full mode draw buffers.
+ *
+ * The backend's flush_cb is called from the flush thread, in order, with
+ * the area and pixels LVGL rendered; its lv_display_flush_ready() call
+ * (made from that thread) completes the buffer. The flush_cb must not call
+ * other LVGL functions, lv_display_flush_is_last() included, as LVGL is
+ * already rendering the next area.
+ *
+ * @note Direct mode is not supported: LVGL keeps its buffers in sync by
+ * copying only the last frame's dirty areas, which needs exactly two
+ * buffers. It is replaced by full mode.
+ */
+
+#include <lvgl.h>
+#include <src/display/lv_display_private.h>   // flush_cb, buf_1/buf_2, render_mode
+#include "../misc/spsc_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <semaphore>
+#include <thread>
+
+namespace lv {
+
+/**
+ * @brief Runs a display's flush_cb on its own thread, LVGL renders ahead
+ *
+ * Replaces the display's draw buffers and flush_cb; the destructor restores
+ * both. Non-movable (the flush thread and the display's event list
+ * reference this). Must be created and destroyed on the LVGL thread.
+ */
+class AsyncFlush {
+public:
+    /// Draw buffers in rotation
+    static constexpr uint32_t BUFFERS = 3;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        lv_area_t area;
+        uint8_t buf;
+    };
+
+    struct Buffer {
+        uint8_t* unaligned = nullptr;
+        uint8_t* data = nullptr;
+        std::atomic<bool> free{true};
+    };
+
+    lv_display_t* m_display = nullptr;
+    lv_display_flush_cb_t m_sink = nullptr;     ///< Backend's flush_cb
+
+    lv_draw_buf_t m_draw_buf{};                 ///< LVGL's only draw buffer; data rotates
+    Buffer m_bufs[BUFFERS];
+    uint8_t m_render = 0;                       ///< Buffer LVGL renders into
+
+    lv_draw_buf_t* m_saved_buf[2] = {};
+    lv_display_render_mode_t m_saved_mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+
+    SpscQueue<Job, 4> m_jobs;
+    std::counting_semaphore<> m_job_sem{0};            ///< Queued jobs (+1 to stop)
+    std::counting_semaphore<> m_free_sem{BUFFERS - 1}; ///< Free buffers
+    std::thread m_thread;
+
+    std::atomic<uint32_t> m_flushes{0};
+    uint32_t m_stalls = 0;
+    uint64_t m_stall_us = 0;
+
+    [[nodiscard]] static AsyncFlush* find(lv_display_t* disp) noexcept {
+        const uint32_t n = lv_display_get_event_count(disp);
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_event_dsc_t* dsc = lv_display_get_event_dsc(disp, i);
+            if (lv_event_dsc_get_cb(dsc) == &delete_cb) {
+                return static_cast<AsyncFlush*>(lv_event_dsc_get_user_data(dsc));
+            }
+        }
+        return nullptr;
+    }
+
+    static void delete_cb(lv_event_t* e) {
+        auto* self = static_cast<AsyncFlush*>(lv_event_get_user_data(e));
+        self->stop();
+        self->m_display = nullptr;
+    }
+
+    static void flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
+        AsyncFlush* self = find(disp);
+        if (!self || px_map != self->m_bufs[self->m_render].data) {
+            lv_display_flush_ready(disp);
+            return;
+        }
+        self->submit(*area);
+    }
+
+    /// LVGL thread: queue the rendered buffer and render into a free one
+    void submit(const lv_area_t& area) noexcept {
+        m_jobs.push(Job{area, m_render});
+        m_job_sem.release();
+
+        if (!m_free_sem.try_acquire()) {
+            const Clock::time_point t0 = Clock::now();
+            m_free_sem.acquire();
+            ++m_stalls;
+            m_stall_us += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count());
+        }
+        for (uint8_t i = 0; i < BUFFERS; ++i) {
+            if (m_bufs[i].free.load(std::memory_order_acquire)) {
+                m_bufs[i].free.store(false, std::memory_order_relaxed);
+                m_render = i;
+                break;
+            }
+        }
+        m_draw_buf.data = m_bufs[m_render].data;
+        m_draw_buf.unaligned_data = m_bufs[m_render].unaligned;
+        lv_display_flush_ready(m_display);
+    }
+
+    /// Flush thread: hand jobs to the backend in order
+    void flush_loop() {
+        for (;;) {
+            m_job_sem.acquire();
+            Job job;
+            if (!m_jobs.pop(job)) return;   // Released by stop()
+            m_sink(m_display, &job.area, m_bufs[job.buf].data);
+            m_flushes.fetch_add(1, std::memory_order_relaxed);
+            m_bufs[job.buf].free.store(true, std::memory_order_release);
+            m_free_sem.release();
+        }
+    }
+
+    /// Finish queued jobs and join the flush thread
+    void stop() noexcept {
+        if (!m_thread.joinable()) return;
+        m_job_sem.release();
+        m_thread.join();
+    }
+
+public:
+    /**
+     * @brief Take over a display's flushing
+     *
+     * @param display Display with a copying backend flush_cb (e.g. FBDisplay in copy mode)
+     * @param mode Partial or full (direct is treated as full)
+     * @param buf_size Bytes per buffer (0 = 1/10 screen for partial, a full screen for full)
+     */
+    explicit AsyncFlush(lv_display_t* display,
+                        lv_display_render_mode_t mode = LV_DISPLAY_RENDER_MODE_PARTIAL,
+                        uint32_t buf_size = 0) noexcept {
+        if (!display || !display->flush_cb) {
+            LV_LOG_WARN("AsyncFlush: display has no flush_cb");
+            return;
+        }
+        if (display->buf_2 && display->render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) {
+            LV_LOG_WARN("AsyncFlush: zero-copy backend (double-buffered direct/full) not supported");
+            return;
+        }
+        if (mode == LV_DISPLAY_RENDER_MODE_DIRECT) {
+            LV_LOG_WARN("AsyncFlush: direct mode needs two buffers, using full mode");
+            mode = LV_DISPLAY_RENDER_MODE_FULL;
+        }
+
+        const uint32_t w = static_cast<uint32_t>(lv_display_get_horizontal_resolution(display));
+        uint32_t h = static_cast<uint32_t>(lv_display_get_vertical_resolution(display));
+        const lv_color_format_t cf = lv_display_get_color_format(display);
+        const uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
+        if (buf_size == 0) {
+            buf_size = mode == LV_DISPLAY_RENDER_MODE_FULL ? stride * h : stride * LV_MAX(h / 10, 1u);
+        }
+        if (mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+            h = buf_size / stride;
+        }
+        if (h == 0 || stride * h > buf_size) {
+            LV_LOG_WARN("AsyncFlush: buffer of %u bytes is too small", static_cast<unsigned>(buf_size));
+            return;
+        }
+
+        for (Buffer& b : m_bufs) {
+            b.unaligned = static_cast<uint8_t*>(lv_malloc(buf_size + LV_DRAW_BUF_ALIGN - 1));
+            if (!b.unaligned) {
+                LV_LOG_WARN("AsyncFlush: out of memory");
+                for (Buffer& f : m_bufs) {
+                    lv_free(f.unaligned);
+                    f.unaligned = nullptr;
+                }
+                return;
+            }
+            b.data = static_cast<uint8_t*>(lv_draw_buf_align(b.unaligned, cf));
+        }
+        m_bufs[0].free.store(false, std::memory_order_relaxed);
+        lv_draw_buf_init(&m_draw_buf, w, h, cf, stride, m_bufs[0].data, buf_size);
+        m_draw_buf.unaligned_data = m_bufs[0].unaligned;
+
+        m_display = display;
+        m_sink = display->flush_cb;
+        m_saved_buf[0] = display->buf_1;
+        m_saved_buf[1] = display->buf_2;
+        m_saved_mode = display->render_mode;
+
+        lv_display_set_draw_buffers(display, &m_draw_buf, nullptr);
+        lv_display_set_render_mode(display, mode);
+        lv_display_add_event_cb(display, &delete_cb, LV_EVENT_DELETE, this);
+        lv_display_set_flush_cb(display, &flush_cb);
+        m_thread = std::thread([this] { flush_loop(); });
+    }
+
+    /// Drain the flush thread and give the display its own buffers and flush_cb back
+    ~AsyncFlush() {
+        stop();
+        if (m_display) {
+            lv_display_remove_event_cb_with_user_data(m_display, &delete_cb, this);
+            lv_display_set_flush_cb(m_display, m_sink);
+            lv_display_set_draw_buffers(m_display, m_saved_buf[0], m_saved_buf[1]);
+            lv_display_set_render_mode(m_display, m_saved_mode);
+            lv_obj_invalidate(lv_display_get_screen_active(m_display));
+        }
+        for (Buffer& b : m_bufs) lv_free(b.unaligned);
+    }
+
+    AsyncFlush(const AsyncFlush&) = delete;
+    AsyncFlush& operator=(const AsyncFlush&) = delete;
+
+    /// Check if the display is being flushed asynchronously
+    [[nodiscard]] bool active() const noexcept { return m_thread.joinable(); }
+
+    /// Areas handed to the backend so far
+    [[nodiscard]] uint32_t flushes() const noexcept {
+        return m_flushes.load(std::memory_order_relaxed);
+    }
+
+    /// Times LVGL had to wait for a free buffer
+    [[nodiscard]] uint32_t stalls() const noexcept { return m_stalls; }
+
+    /// Total time LVGL waited for a free buffer
+    [[nodiscard]] uint64_t stall_us() const noexcept { return m_stall_us; }
+
+    /// Print flush statistics with LV_LOG_USER
+    void log() const noexcept {
+        LV_LOG_USER("AsyncFlush: flushes=%u stalls=%u stalled=%ums",
+                    static_cast<unsigned>(flushes()), static_cast<unsigned>(m_stalls),
+                    static_cast<unsigned>(m_stall_us / 1000));
+    }
+};
+
+} // namespace lv
@@ -10,6 +10,7 @@
 
 #include <lvgl.h>
 #include "object.hpp"
+#include "event.hpp"
 
 namespace lv {
 
@@ -286,6 +287,38 @@ public:
         return static_cast<T*>(lv_obj_get_user_data(child.get()));
     }
 
+    // ==================== Delegated Events ====================
+
+    /**
+     * @brief Handle an event for every child of container with one handler
+     *
+     * See EventMixin::delegate(). The handler is a member of the derived
+     * component and receives the index of the child the event came from.
+     *
+     * @code
+     * lv::ObjectView build(lv::ObjectView parent) {
+     *     auto grid = lv::grid(parent);
+     *     for (int i = 0; i < 200; ++i) lv::Button(grid).text(names[i]);
+     *     delegate<&Keypad::on_key>(grid, lv::kEvent::clicked, &lv_button_class);
+     *     return grid;
+     * }
+     * void on_key(lv::Event, uint32_t index);
+     * @endcode
+     */
+    template<auto MemFn>
+    void delegate(ObjectView container, lv_event_code_t code,
+                  const lv_obj_class_t* filter = nullptr) noexcept {
+        detail::delegate<MemFn>(container.get(), code, static_cast<Derived*>(this), filter);
+    }
+
+    /// Delegate on the component root (call after mount, e.g. in on_mount())
+    template<auto MemFn>
+    void delegate(lv_event_code_t code, const lv_obj_class_t* filter = nullptr) noexcept {
+        if (m_root) {
+            detail::delegate<MemFn>(m_root, code, static_cast<Derived*>(this), filter);
+        }
+    }
+
     // ==================== Static Helpers ====================
 
     /**
@@ -5,6 +5,8 @@
  * @brief Display and input device wrappers
  *
  * Provides clean C++ abstractions for LVGL display backends.
+ * The framebuffer and DRM/KMS backends live in display/fb_display.hpp
+ * and display/drm_display.hpp.
  */
 
 #include <lvgl.h>
@@ -19,12 +21,19 @@ namespace lv {
 class Display {
     lv_display_t* m_display;
 
+protected:
+    /// For backends that create the display after setting up the device
+    void set_display(lv_display_t* d) noexcept { m_display = d; }
+
 public:
     constexpr Display(lv_display_t* d) noexcept : m_display(d) {}
 
     [[nodiscard]] constexpr lv_display_t* get() const noexcept { return m_display; }
     [[nodiscard]] constexpr operator lv_display_t*() const noexcept { return m_display; }
 
+    /// Check if the backend created a display
+    [[nodiscard]] constexpr bool valid() const noexcept { return m_display != nullptr; }
+
     [[nodiscard]] int32_t width() const noexcept {
         return lv_display_get_horizontal_resolution(m_display);
     }
@@ -115,29 +124,4 @@ public:
 #endif
 
 
-#if LV_USE_LINUX_FBDEV
-/**
- * @brief Linux framebuffer display backend
- */
-class FBDisplay : public Display {
-public:
-    FBDisplay()
-        : Display(lv_linux_fbdev_create()) {
-    }
-};
-#endif
-
-
-#if LV_USE_LINUX_DRM
-/**
- * @brief Linux DRM/KMS display backend
- */
-class DRMDisplay : public Display {
-public:
-    DRMDisplay()
-        : Display(lv_linux_drm_create()) {
-    }
-};
-#endif
-
 } // namespace lv
@@ -8,7 +8,7 @@
  * 1. Stateless lambdas (convertible to function pointer) - ZERO overhead
  * 2. Member function pointers with instance - ZERO overhead (uses user_data)
  * 3. Function pointers - ZERO overhead
- * 4. Optional std::function support (requires LV_CPP_USE_STD_FUNCTION)
+ * 4. Capturing lambdas - stored in a fixed pool of InplaceFunction slots (no heap)
  *
  * ## Usage Examples
  *
@@ -34,6 +34,9 @@
  *     void on_click(lv::Event e) { ... }
  * };
  * btn.on<&MyApp::on_click>(lv::kEvent::clicked, this);
+ *
+ * // 6. Capturing lambda (captures up to LV_CPP_CALLBACK_CAPTURE_SIZE bytes)
+ * btn.on_click([this, id](lv::Event) { select(id); });
  * @endcode
  *
  * ## Why function pointers with lv::Event need template syntax
@@ -52,12 +55,24 @@
 #include <cstring>
 #include <utility>
 #include "object.hpp"  // For ObjectView
+#include "event_table.hpp"
+#include "function.hpp"
 
 #ifdef LV_CPP_USE_STD_FUNCTION
 #include <functional>
 #include <memory>
 #endif
 
+/// Inline capture storage per capturing callback (bytes)
+#ifndef LV_CPP_CALLBACK_CAPTURE_SIZE
+#define LV_CPP_CALLBACK_CAPTURE_SIZE (4 * sizeof(void*))
+#endif
+
+/// Number of capturing callbacks that can be alive at the same time
+#ifndef LV_CPP_CALLBACK_POOL_SIZE
+#define LV_CPP_CALLBACK_POOL_SIZE 64
+#endif
+
 namespace lv {
 
 // ==================== Event Types ====================
@@ -241,6 +256,256 @@ struct MemberTrampolineNoArg {
     }
 };
 
+/**
+ * @brief Routed (EventTable) trampoline for member functions
+ *
+ * Same signature detection as EventMixin::on(): void(Event),
+ * void(lv_event_t*) or void().
+ */
+template<auto MemFn, typename T>
+struct RoutedMemberTrampoline {
+    static void callback(lv_event_t* e, void* user_data) {
+        auto* instance = static_cast<T*>(user_data);
+        if constexpr (std::is_invocable_v<decltype(MemFn), T*, Event>) {
+            (instance->*MemFn)(Event(e));
+        } else if constexpr (std::is_invocable_v<decltype(MemFn), T*, lv_event_t*>) {
+            (instance->*MemFn)(e);
+        } else {
+            (instance->*MemFn)();
+        }
+    }
+};
+
+// ==================== Capturing callback pool ====================
+
+/// Type-erased capturing handler with inline capture storage
+using CapturingEventFn = InplaceFunction<void(Event), LV_CPP_CALLBACK_CAPTURE_SIZE>;
+
+/**
+ * @brief Pool slot: one capturing handler and the descriptor it belongs to
+ *
+ * Slots live in a static array, so capturing callbacks never touch the heap.
+ * A slot is released when its object is deleted or its descriptor is
+ * removed with callback_pool_remove().
+ */
+struct CallbackSlot {
+    lv_obj_t* obj = nullptr;          ///< Owner object (nullptr = free slot)
+    lv_event_dsc_t* dsc = nullptr;    ///< Descriptor returned by lv_obj_add_event_cb()
+    lv_event_code_t code{};
+    bool running = false;             ///< Handler is executing
+    bool removed = false;             ///< Removed while running: released when it returns
+    CapturingEventFn fn;
+};
+
+inline CallbackSlot g_callback_pool[LV_CPP_CALLBACK_POOL_SIZE];
+
+inline void callback_slot_release(CallbackSlot& slot) noexcept {
+    if (slot.running) {
+        slot.removed = true;   // Don't destroy the callable under its own call
+        return;
+    }
+    slot.fn.reset();
+    slot.obj = nullptr;
+    slot.dsc = nullptr;
+    slot.removed = false;
+}
+
+/// Invokes the slot's callable; DELETE handlers release their own slot afterwards
+inline void callback_slot_trampoline(lv_event_t* e) {
+    auto* slot = static_cast<CallbackSlot*>(lv_event_get_user_data(e));
+    if (!slot->obj || slot->removed) return;
+    slot->running = true;
+    slot->fn(Event(e));
+    slot->running = false;
+    if (slot->removed || lv_event_get_code(e) == LV_EVENT_DELETE) {
+        callback_slot_release(*slot);
+    }
+}
+
+/// Check if the slot's descriptor is still registered on its object
+[[nodiscard]] inline bool callback_slot_attached(const CallbackSlot& slot) noexcept {
+    const uint32_t n = lv_obj_get_event_count(slot.obj);
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_event_dsc_t* dsc = lv_obj_get_event_dsc(slot.obj, i);
+        if (dsc == slot.dsc && lv_event_dsc_get_user_data(dsc) == &slot) return true;
+    }
+    return false;
+}
+
+/// Release slots whose descriptor was removed directly with lv_obj_remove_event_*()
+inline uint32_t callback_pool_reclaim() noexcept {
+    uint32_t n = 0;
+    for (auto& slot : g_callback_pool) {
+        if (slot.obj && !slot.running && !callback_slot_attached(slot)) {
+            callback_slot_release(slot);
+            ++n;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Remove an event descriptor of obj, releasing its pool slot if it has one
+ *
+ * Safe to call from the handler itself; its slot is released when it returns.
+ *
+ * @return false if dsc is not registered on obj
+ */
+inline bool callback_pool_remove(lv_obj_t* obj, lv_event_dsc_t* dsc) noexcept {
+    for (auto& slot : g_callback_pool) {
+        if (slot.obj == obj && slot.dsc == dsc) {
+            callback_slot_release(slot);
+            break;
+        }
+    }
+    return lv_obj_remove_event_dsc(obj, dsc);
+}
+
+/// Releases all non-DELETE slots of the object being deleted
+inline void callback_pool_on_delete(lv_event_t* e) {
+    lv_obj_t* obj = lv_event_get_current_target_obj(e);
+    for (auto& slot : g_callback_pool) {
+        if (slot.obj == obj && slot.code != LV_EVENT_DELETE) {
+            callback_slot_release(slot);
+        }
+    }
+}
+
+/**
+ * @brief Store fn in a free pool slot and register it on obj
+ *
+ * @return The event descriptor, or nullptr if the pool is exhausted
+ */
+inline lv_event_dsc_t* callback_pool_add(lv_obj_t* obj, lv_event_code_t code, CapturingEventFn&& fn) noexcept {
+    CallbackSlot* free_slot = nullptr;
+    bool has_cleanup = false;
+    for (auto& slot : g_callback_pool) {
+        if (!slot.obj) {
+            if (!free_slot) free_slot = &slot;
+        } else if (slot.obj == obj && slot.code != LV_EVENT_DELETE) {
+            has_cleanup = true;  // Object already has the release callback
+        }
+    }
+    if (!free_slot && callback_pool_reclaim() > 0) {
+        for (auto& slot : g_callback_pool) {
+            if (!slot.obj) {
+                free_slot = &slot;
+                break;
+            }
+        }
+    }
+    if (!free_slot) {
+        LV_LOG_ERROR("capturing callback pool full (LV_CPP_CALLBACK_POOL_SIZE=%d)",
+                     LV_CPP_CALLBACK_POOL_SIZE);
+        LV_ASSERT_MSG(false, "capturing callback pool full, raise LV_CPP_CALLBACK_POOL_SIZE");
+        return nullptr;
+    }
+
+    free_slot->obj = obj;
+    free_slot->code = code;
+    free_slot->fn = std::move(fn);
+    free_slot->dsc = lv_obj_add_event_cb(obj, &callback_slot_trampoline, code, free_slot);
+    if (code != LV_EVENT_DELETE && !has_cleanup) {
+        lv_obj_add_event_cb(obj, &callback_pool_on_delete, LV_EVENT_DELETE, nullptr);
+    }
+    return free_slot->dsc;
+}
+
+/// Number of pool slots in use
+inline uint32_t callback_pool_used() noexcept {
+    uint32_t n = 0;
+    for (const auto& slot : g_callback_pool) {
+        if (slot.obj) ++n;
+    }
+    return n;
+}
+
+// ==================== Delegated (container) handlers ====================
+
+/// Heap record for one delegate() registration (freed with the container)
+struct DelegateData {
+    void* instance;
+    const lv_obj_class_t* filter;
+};
+
+/// Resolve the direct child of container that contains the event target
+inline lv_obj_t* delegate_child(lv_event_t* e, lv_obj_t* container) noexcept {
+    lv_obj_t* obj = lv_event_get_target_obj(e);
+    while (obj) {
+        lv_obj_t* parent = lv_obj_get_parent(obj);
+        if (parent == container) return obj;
+        obj = parent;
+    }
+    return nullptr;  // Event on the container itself
+}
+
+/// Make new children bubble their events up to the delegating container
+inline void delegate_adopt_child(lv_event_t* e, void*) {
+    auto* child = static_cast<lv_obj_t*>(lv_event_get_param(e));
+    if (child && lv_obj_get_parent(child) == lv_event_get_current_target_obj(e)) {
+        lv_obj_add_flag(child, LV_OBJ_FLAG_EVENT_BUBBLE);
+    }
+}
+
+inline void delegate_free(lv_event_t*, void* user_data) {
+    lv_free(user_data);
+}
+
+/**
+ * @brief Routed trampoline that resolves the child index for delegate()
+ *
+ * Supported signatures: void(Event, uint32_t index) and
+ * void(ObjectView child, uint32_t index).
+ */
+template<auto MemFn, typename T>
+struct DelegateTrampoline {
+    static void callback(lv_event_t* e, void* user_data) {
+        auto* data = static_cast<DelegateData*>(user_data);
+        lv_obj_t* child = delegate_child(e, lv_event_get_current_target_obj(e));
+        if (!child || (data->filter && !lv_obj_check_type(child, data->filter))) {
+            return;
+        }
+        auto* instance = static_cast<T*>(data->instance);
+        const uint32_t index = static_cast<uint32_t>(lv_obj_get_index(child));
+        if constexpr (std::is_invocable_v<decltype(MemFn), T*, Event, uint32_t>) {
+            (instance->*MemFn)(Event(e), index);
+        } else {
+            (instance->*MemFn)(ObjectView(child), index);
+        }
+    }
+};
+
+/**
+ * @brief Register a delegated handler on container (shared by EventMixin and Component)
+ */
+template<auto MemFn, typename T>
+inline bool delegate(lv_obj_t* container, lv_event_code_t code, T* instance,
+                     const lv_obj_class_t* filter) noexcept {
+    static_assert(std::is_invocable_v<decltype(MemFn), T*, Event, uint32_t> ||
+                  std::is_invocable_v<decltype(MemFn), T*, ObjectView, uint32_t>,
+        "Delegate handler must be void(lv::Event, uint32_t index) or "
+        "void(lv::ObjectView child, uint32_t index)");
+
+    EventTable* table = EventTable::of(container);
+    if (!table) return false;
+    auto* data = static_cast<DelegateData*>(lv_malloc(sizeof(DelegateData)));
+    if (!data) return false;
+    *data = {instance, filter};
+
+    table->add(code, &DelegateTrampoline<MemFn, T>::callback, data);
+    table->add(LV_EVENT_DELETE, &delegate_free, data);
+
+    // Existing children bubble now, future children when they are created
+    const uint32_t n = lv_obj_get_child_count(container);
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_obj_add_flag(lv_obj_get_child(container, static_cast<int32_t>(i)), LV_OBJ_FLAG_EVENT_BUBBLE);
+    }
+    if (!table->contains(LV_EVENT_CHILD_CREATED, &delegate_adopt_child)) {
+        table->add(LV_EVENT_CHILD_CREATED, &delegate_adopt_child);
+    }
+    return true;
+}
+
 } // namespace detail
 
 
@@ -324,9 +589,9 @@ public:
      *     auto target = e.target();
      * });
      *
-     * // ERROR: capturing lambda - use member function instead
+     * // Capturing lambdas select the pooled overload below
      * int counter = 0;
-     * btn.on(lv::kEvent::clicked, [&counter](lv::Event e) { counter++; }); // Won't compile
+     * btn.on(lv::kEvent::clicked, [&counter](lv::Event e) { counter++; });
      * @endcode
      */
     template<typename F>
@@ -384,11 +649,64 @@ public:
     }
 
     /**
-     * @brief Deleted overload for capturing lambdas - provides helpful error message
+     * @brief Add event callback using a capturing lambda
+     *
+     * The lambda is moved into a slot of a static pool
+     * (LV_CPP_CALLBACK_POOL_SIZE slots, each with LV_CPP_CALLBACK_CAPTURE_SIZE
+     * bytes of inline storage) - no heap allocation. The slot is released
+     * automatically when the object is deleted. Captures that don't fit are a
+     * compile error; capture a pointer to a struct instead, or use the
+     * member function pattern: btn.on<&MyClass::handler>(code, this).
+     *
+     * A full pool is an LV_ASSERT failure; use add_event_cb() to check for it
+     * or to remove the handler later.
+     *
+     * @code
+     * btn.on(lv::kEvent::clicked, [this, index](lv::Event) { select(index); });
+     * @endcode
+     */
+    template<typename F>
+        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F> &&
+                  !std::is_pointer_v<std::decay_t<F>> && !std::is_function_v<std::remove_reference_t<F>>)
+    Derived& on(lv_event_code_t code, F&& fn) noexcept {
+        (void)add_event_cb(code, std::forward<F>(fn));
+        return *static_cast<Derived*>(this);
+    }
+
+    /**
+     * @brief Add a capturing lambda like on(), returning its descriptor
+     *
+     * @code
+     * lv_event_dsc_t* dsc = btn.add_event_cb(lv::kEvent::clicked, [this](lv::Event) { ... });
+     * if (!dsc) { ... }                 // Pool full
+     * btn.remove_event_dsc(dsc);        // Also releases the pool slot
+     * @endcode
+     *
+     * @return The descriptor, or nullptr if the pool is full
      */
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
-    Derived& on(lv_event_code_t code, F&& fn) = delete;  // Use member function: btn.on<&MyClass::handler>(event, this)
+        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F> &&
+                  !std::is_pointer_v<std::decay_t<F>> && !std::is_function_v<std::remove_reference_t<F>>)
+    [[nodiscard]] lv_event_dsc_t* add_event_cb(lv_event_code_t code, F&& fn) noexcept {
+        static_assert(detail::CapturingEventFn::fits<F>,
+            "Lambda captures exceed LV_CPP_CALLBACK_CAPTURE_SIZE bytes. Capture a pointer "
+            "to a struct, raise LV_CPP_CALLBACK_CAPTURE_SIZE, or use the member function "
+            "pattern: btn.on<&MyClass::handler>(code, this)");
+        return detail::callback_pool_add(obj(), code, detail::CapturingEventFn(std::forward<F>(fn)));
+    }
+
+    /**
+     * @brief Remove an event descriptor, releasing the pool slot of a capturing handler
+     *
+     * Use instead of lv_obj_remove_event_dsc() for descriptors from
+     * add_event_cb(); slots of descriptors removed directly are only
+     * reclaimed when the pool runs full.
+     *
+     * @return false if dsc is not registered on this object
+     */
+    bool remove_event_dsc(lv_event_dsc_t* dsc) noexcept {
+        return detail::callback_pool_remove(obj(), dsc);
+    }
 
     /// @deprecated Use on() instead
     template<typename F>
@@ -469,6 +787,89 @@ public:
         return on_simple<MemFn>(code, instance);
     }
 
+    // ==================== Routed Callbacks (EventTable) ====================
+
+    /**
+     * @brief Add a handler through the object's EventTable
+     *
+     * All routed handlers of an object share one LV_EVENT_ALL descriptor
+     * and are looked up by event code (bitmask + sorted array), so adding
+     * more handlers doesn't slow down unrelated events such as draw events.
+     * Prefer this over on() for widgets with several handlers.
+     *
+     * @code
+     * slider.route<&App::on_changed>(lv::kEvent::value_changed, this)
+     *       .route<&App::on_released>(lv::kEvent::released, this);
+     * @endcode
+     */
+    template<auto MemFn, typename T>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    Derived& route(lv_event_code_t code, T* instance) noexcept {
+        if (EventTable* table = EventTable::of(obj())) {
+            table->add(code, &detail::RoutedMemberTrampoline<MemFn, T>::callback, instance);
+        }
+        return *static_cast<Derived*>(this);
+    }
+
+    /// Routed handler from a stateless lambda (lv_event_t* or lv::Event)
+    template<typename F>
+        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+    Derived& route(lv_event_code_t code, F&& /*fn*/) noexcept {
+        static_assert(std::is_empty_v<std::decay_t<F>> && std::is_default_constructible_v<std::decay_t<F>>,
+            "Routed lambdas must be stateless (no captures)");
+        auto wrapper = [](lv_event_t* e, void*) {
+            using Fn = std::decay_t<F>;
+            if constexpr (StatelessCallable<Fn, lv_event_t*>) Fn{}(e);
+            else Fn{}(Event(e));
+        };
+        if (EventTable* table = EventTable::of(obj())) {
+            table->add(code, +wrapper, nullptr);
+        }
+        return *static_cast<Derived*>(this);
+    }
+
+    /// Routed handler from a raw function pointer taking user_data
+    Derived& route(lv_event_code_t code, RoutedEventCb cb, void* user_data) noexcept {
+        if (EventTable* table = EventTable::of(obj())) {
+            table->add(code, cb, user_data);
+        }
+        return *static_cast<Derived*>(this);
+    }
+
+    // ==================== Delegated Callbacks ====================
+
+    /**
+     * @brief Handle an event for all children with one handler on this container
+     *
+     * Instead of one event descriptor per row/cell, a single handler on the
+     * container receives the event (children get LV_OBJ_FLAG_EVENT_BUBBLE,
+     * including children created later) and is called with the index of the
+     * direct child the event came from.
+     *
+     * Handler signatures: void(lv::Event, uint32_t index) or
+     * void(lv::ObjectView child, uint32_t index).
+     *
+     * @param code Event code (e.g. lv::kEvent::clicked)
+     * @param instance Handler instance
+     * @param filter Only children of this class (e.g. &lv_button_class), nullptr = all
+     *
+     * @code
+     * list.delegate<&Inbox::on_row_clicked>(lv::kEvent::clicked, this, &lv_list_button_class);
+     *
+     * void Inbox::on_row_clicked(lv::Event e, uint32_t index) { open(index); }
+     * @endcode
+     *
+     * @note Only direct children bubble automatically. Clickable grandchildren
+     * need LV_OBJ_FLAG_EVENT_BUBBLE themselves.
+     */
+    template<auto MemFn, typename T>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    Derived& delegate(lv_event_code_t code, T* instance,
+                      const lv_obj_class_t* filter = nullptr) noexcept {
+        detail::delegate<MemFn>(obj(), code, instance, filter);
+        return *static_cast<Derived*>(this);
+    }
+
     // ==================== Convenience Methods ====================
 
     /// Shorthand for clicked event (stateless lambda with lv_event_t* or lv::Event)
@@ -484,10 +885,13 @@ public:
         return on<MemFn>(LV_EVENT_CLICKED, instance);
     }
 
-    /// Deleted: capturing lambda - use member function instead
+    /// Capturing lambda (pooled, no heap) - see on(code, F&&)
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
-    Derived& on_click(F&& fn) = delete;  // Use member function: btn.on_click<&MyClass::handler>(this)
+        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F> &&
+                  !std::is_pointer_v<std::decay_t<F>>)
+    Derived& on_click(F&& fn) noexcept {
+        return on(LV_EVENT_CLICKED, std::forward<F>(fn));
+    }
 
     /// Shorthand for value_changed event (stateless lambda with lv_event_t* or lv::Event)
     template<typename F>
@@ -502,10 +906,13 @@ public:
         return on<MemFn>(LV_EVENT_VALUE_CHANGED, instance);
     }
 
-    /// Deleted: capturing lambda - use member function instead
+    /// Capturing lambda (pooled, no heap) - see on(code, F&&)
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
-    Derived& on_value_changed(F&& fn) = delete;  // Use member function: btn.on_value_changed<&MyClass::handler>(this)
+        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F> &&
+                  !std::is_pointer_v<std::decay_t<F>>)
+    Derived& on_value_changed(F&& fn) noexcept {
+        return on(LV_EVENT_VALUE_CHANGED, std::forward<F>(fn));
+    }
 
     /// Shorthand for pressed event (stateless lambda with lv_event_t* or lv::Event)
     template<typename F>
@@ -521,15 +928,21 @@ public:
         return on(LV_EVENT_RELEASED, std::forward<F>(fn));
     }
 
-    /// Deleted: capturing lambda - use member function instead
+    /// Capturing lambda (pooled, no heap) - see on(code, F&&)
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
-    Derived& on_pressed(F&& fn) = delete;  // Use member function: btn.on<&MyClass::handler>(lv::kEvent::pressed, this)
+        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F> &&
+                  !std::is_pointer_v<std::decay_t<F>>)
+    Derived& on_pressed(F&& fn) noexcept {
+        return on(LV_EVENT_PRESSED, std::forward<F>(fn));
+    }
 
-    /// Deleted: capturing lambda - use member function instead
+    /// Capturing lambda (pooled, no heap) - see on(code, F&&)
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
-    Derived& on_released(F&& fn) = delete;  // Use member function: btn.on<&MyClass::handler>(lv::kEvent::released, this)
+        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F> &&
+                  !std::is_pointer_v<std::decay_t<F>>)
+    Derived& on_released(F&& fn) noexcept {
+        return on(LV_EVENT_RELEASED, std::forward<F>(fn));
+    }
 
     /// Shorthand for focused event (stateless lambda with lv_event_t* or lv::Event)
     template<typename F>
@@ -557,15 +970,21 @@ public:
         return on<MemFn>(LV_EVENT_DEFOCUSED, instance);
     }
 
-    /// Deleted: capturing lambda - use member function instead
+    /// Capturing lambda (pooled, no heap) - see on(code, F&&)
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
-    Derived& on_focused(F&& fn) = delete;  // Use member function: btn.on_focused<&MyClass::handler>(this)
+        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F> &&
+                  !std::is_pointer_v<std::decay_t<F>>)
+    Derived& on_focused(F&& fn) noexcept {
+        return on(LV_EVENT_FOCUSED, std::forward<F>(fn));
+    }
 
-    /// Deleted: capturing lambda - use member function instead
+    /// Capturing lambda (pooled, no heap) - see on(code, F&&)
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
-    Derived& on_defocused(F&& fn) = delete;  // Use member function: btn.on_defocused<&MyClass::handler>(this)
+        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F> &&
+                  !std::is_pointer_v<std::decay_t<F>>)
+    Derived& on_defocused(F&& fn) noexcept {
+        return on(LV_EVENT_DEFOCUSED, std::forward<F>(fn));
+    }
 
     // ==================== Multi-click Events ====================
 
@@ -705,13 +1124,12 @@ public:
 
     // ==================== Notes ====================
     //
-    // Capturing lambdas are intentionally NOT supported.
-    // When you try to use a capturing lambda, you'll get a compile error
-    // pointing you to use a member function instead:
+    // Capturing lambdas are stored in a fixed pool (see on(code, F&&)).
+    // Member functions remain the zero-cost option for stateful callbacks:
     //
     //   btn.on_click<&MyClass::handler>(this);
     //
-    // This is zero-cost and matches how C handles stateful callbacks (via user_data).
+    // This matches how C handles stateful callbacks (via user_data).
 };
 
 
@@ -0,0 +1,458 @@
+#pragma once
+
+/**
+ * @file event_indev.hpp
+ * @brief Event-driven input device fed from a reader thread
+ *
+ * LVGL polls input devices from a read timer, so touch latency is quantized
+ * to the timer period and the loop wakes up even when nothing happens.
+ * EventIndev puts the indev in LV_INDEV_MODE_EVENT instead: a reader thread
+ * blocks on an fd (evdev or any other source), pushes decoded samples into a
+ * lock-free queue and wakes the LVGL thread, which calls lv_indev_read()
+ * only when data is pending.
+ *
+ * Usage:
+ * @code
+ * lv::EventIndev touch(lv::indev_type::pointer);
+ * touch.open_evdev("/dev/input/event0");
+ *
+ * while (true) {
+ *     uint32_t idle_ms = lv_timer_handler();
+ *     touch.wait(idle_ms);   // Sleeps until input arrives or a timer is due
+ * }
+ * @endcode
+ *
+ * @note Only push()/push_*() are safe to call from other threads. Everything
+ * else must run on the LVGL thread.
+ */
+
+#include <lvgl.h>
+#include "indev.hpp"
+#include "../misc/spsc_queue.hpp"
+#include <atomic>
+#include <cstdint>
+
+#ifdef __linux__
+#include <thread>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+#endif
+
+namespace lv {
+
+/**
+ * @brief One decoded input sample
+ *
+ * Trivially copyable so it can travel through SpscQueue.
+ */
+struct IndevSample {
+    lv_point_t point{0, 0};             ///< Pointer position (pointer devices)
+    uint32_t key = 0;                   ///< LV_KEY_* or character (keypad devices)
+    int16_t enc_diff = 0;               ///< Encoder steps since last sample
+    lv_indev_state_t state = LV_INDEV_STATE_RELEASED;
+    uint32_t time_ms = 0;               ///< lv_tick_get() when the sample was pushed
+};
+
+/**
+ * @brief Event-mode input device with a lock-free sample queue
+ *
+ * Owns its lv_indev_t. Non-movable because the indev's driver_data points
+ * back to this object.
+ *
+ * @tparam QueueSize Sample queue capacity (power of two). Samples pushed
+ *                   while the queue is full are dropped and counted.
+ */
+template<size_t QueueSize = 64>
+class BasicEventIndev {
+public:
+    /// Custom fd decoder: read from fd, push() samples. Return false to stop.
+    using ReadFn = bool (*)(int fd, BasicEventIndev& self, void* ctx);
+
+private:
+    lv_indev_t* m_indev;
+    SpscQueue<IndevSample, QueueSize> m_queue;
+    IndevSample m_last{};
+    std::atomic<uint32_t> m_dropped{0};
+
+#ifdef __linux__
+    int m_wake_fd = -1;
+    int m_stop_fd = -1;
+    int m_src_fd = -1;
+    bool m_owns_src = false;
+    std::thread m_reader;
+
+    ReadFn m_read_fn = nullptr;
+    void* m_read_ctx = nullptr;
+
+    /// evdev decoder state (reader thread only)
+    struct EvdevState {
+        IndevSample pending{};
+        int32_t abs_min_x = 0, abs_max_x = 0;
+        int32_t abs_min_y = 0, abs_max_y = 0;
+        int32_t hor_res = 0, ver_res = 0;
+        bool dirty = false;
+    } m_evdev;
+#endif
+
+    static void read_cb(lv_indev_t* indev, lv_indev_data_t* data) {
+        auto* self = static_cast<BasicEventIndev*>(lv_indev_get_driver_data(indev));
+        IndevSample sample;
+        if (self->m_queue.pop(sample)) {
+            self->m_last = sample;
+        }
+        data->point = self->m_last.point;
+        data->key = self->m_last.key;
+        data->enc_diff = self->m_last.enc_diff;
+        data->state = self->m_last.state;
+        data->continue_reading = !self->m_queue.empty();
+        // Encoder steps are relative: report them exactly once
+        self->m_last.enc_diff = 0;
+    }
+
+public:
+    /// Create an event-mode input device of the given type
+    explicit BasicEventIndev(lv_indev_type_t type = LV_INDEV_TYPE_POINTER) noexcept
+        : m_indev(lv_indev_create()) {
+        lv_indev_set_type(m_indev, type);
+        lv_indev_set_read_cb(m_indev, &read_cb);
+        lv_indev_set_driver_data(m_indev, this);
+        lv_indev_set_mode(m_indev, LV_INDEV_MODE_EVENT);
+#ifdef __linux__
+        m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        m_stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+    }
+
+    ~BasicEventIndev() {
+#ifdef __linux__
+        close();
+        if (m_wake_fd >= 0) ::close(m_wake_fd);
+        if (m_stop_fd >= 0) ::close(m_stop_fd);
+#endif
+        if (m_indev) {
+            lv_indev_delete(m_indev);
+        }
+    }
+
+    // Non-copyable, non-movable (driver_data and reader thread reference this)
+    BasicEventIndev(const BasicEventIndev&) = delete;
+    BasicEventIndev& operator=(const BasicEventIndev&) = delete;
+
+    /// Get underlying input device pointer
+    [[nodiscard]] lv_indev_t* get() const noexcept { return m_indev; }
+
+    /// Non-owning Indev view for further configuration (group, cursor, ...)
+    [[nodiscard]] Indev indev() const noexcept { return Indev(m_indev); }
+
+    /// Time stamp (lv_tick_get() domain) of the sample the last read reported
+    [[nodiscard]] uint32_t sample_time() const noexcept { return m_last.time_ms; }
+
+    // ==================== Producer Side (any thread) ====================
+
+    /**
+     * @brief Queue a sample and wake the LVGL thread
+     *
+     * Safe to call from exactly one producer thread (the reader thread when
+     * a source is open). Stamps the sample with lv_tick_get() if time_ms is 0.
+     *
+     * @return false if the queue was full and the sample was dropped
+     */
+    bool push(IndevSample sample) noexcept {
+        if (sample.time_ms == 0) {
+            sample.time_ms = lv_tick_get();
+        }
+        if (!m_queue.push(sample)) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+#ifdef __linux__
+        if (m_wake_fd >= 0) {
+            uint64_t one = 1;
+            [[maybe_unused]] auto n = ::write(m_wake_fd, &one, sizeof(one));
+        }
+#endif
+        return true;
+    }
+
+    /// Queue a pointer sample
+    bool push_point(int32_t x, int32_t y, bool pressed) noexcept {
+        IndevSample s;
+        s.point = {x, y};
+        s.state = pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+        return push(s);
+    }
+
+    /// Queue a keypad sample
+    bool push_key(uint32_t key, bool pressed) noexcept {
+        IndevSample s;
+        s.key = key;
+        s.state = pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+        return push(s);
+    }
+
+    /// Queue an encoder sample
+    bool push_encoder(int16_t diff, bool pressed) noexcept {
+        IndevSample s;
+        s.enc_diff = diff;
+        s.state = pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+        return push(s);
+    }
+
+    // ==================== Consumer Side (LVGL thread) ====================
+
+    /**
+     * @brief Feed pending samples to LVGL
+     *
+     * Calls lv_indev_read() once; the read callback sets continue_reading
+     * so LVGL drains the whole queue in one go.
+     *
+     * @return true if any samples were processed
+     */
+    bool dispatch() noexcept {
+#ifdef __linux__
+        if (m_wake_fd >= 0) {
+            uint64_t count;
+            [[maybe_unused]] auto n = ::read(m_wake_fd, &count, sizeof(count));
+        }
+#endif
+        if (m_queue.empty()) {
+            return false;
+        }
+        lv_indev_read(m_indev);
+        return true;
+    }
+
+    /**
+     * @brief Sleep until input arrives or timeout expires, then dispatch
+     *
+     * Drop-in replacement for lv::sleep_ms() in the main loop: pass the
+     * value returned by lv_timer_handler(). Input interrupts the sleep.
+     *
+     * @return true if input was dispatched
+     */
+    bool wait(uint32_t timeout_ms) noexcept {
+#ifdef __linux__
+        if (m_wake_fd >= 0 && m_queue.empty()) {
+            pollfd pfd{m_wake_fd, POLLIN, 0};
+            int timeout = timeout_ms == LV_NO_TIMER_READY ? -1 : static_cast<int>(timeout_ms);
+            ::poll(&pfd, 1, timeout);
+        }
+#else
+        if (m_queue.empty()) {
+            lv_delay_ms(timeout_ms);
+        }
+#endif
+        return dispatch();
+    }
+
+    /// Wake-up fd for integration in an existing poll()/epoll() loop (-1 if unsupported)
+    [[nodiscard]] int wake_fd() const noexcept {
+#ifdef __linux__
+        return m_wake_fd;
+#else
+        return -1;
+#endif
+    }
+
+    /// Number of queued, not yet dispatched samples
+    [[nodiscard]] size_t pending() const noexcept { return m_queue.size(); }
+
+    /// Number of samples dropped because the queue was full
+    [[nodiscard]] uint32_t dropped() const noexcept {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+#ifdef __linux__
+    // ==================== fd Sources ====================
+
+    /**
+     * @brief Start a reader thread on an arbitrary fd
+     *
+     * The thread blocks in poll() and calls read_fn whenever the fd becomes
+     * readable. read_fn decodes the data and calls push().
+     *
+     * @param fd Readable fd (not closed by EventIndev)
+     * @param read_fn Decoder, runs on the reader thread
+     * @param ctx Passed to read_fn
+     */
+    bool open_fd(int fd, ReadFn read_fn, void* ctx = nullptr) noexcept {
+        close();
+        if (fd < 0 || !read_fn || m_stop_fd < 0) {
+            return false;
+        }
+        m_src_fd = fd;
+        m_owns_src = false;
+        m_read_fn = read_fn;
+        m_read_ctx = ctx;
+        m_reader = std::thread([this] { reader_loop(); });
+        return true;
+    }
+
+    /**
+     * @brief Open a Linux evdev device and start reading it
+     *
+     * Pointer devices map ABS_X/ABS_Y (or ABS_MT_POSITION_*) to the default
+     * display resolution; BTN_TOUCH/BTN_LEFT give the pressed state.
+     * Relative devices (mice) accumulate REL_X/REL_Y; REL_WHEEL becomes
+     * encoder steps. Arrow/enter/escape keys map to LV_KEY_*.
+     *
+     * Must be called on the LVGL thread (reads the display resolution).
+     */
+    bool open_evdev(const char* path) noexcept {
+        close();
+        int fd = ::open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+
+        m_evdev = EvdevState{};
+        lv_display_t* disp = lv_indev_get_display(m_indev);
+        if (!disp) disp = lv_display_get_default();
+        if (disp) {
+            m_evdev.hor_res = lv_display_get_horizontal_resolution(disp);
+            m_evdev.ver_res = lv_display_get_vertical_resolution(disp);
+        }
+
+        input_absinfo info{};
+        if (ioctl(fd, EVIOCGABS(ABS_X), &info) == 0) {
+            m_evdev.abs_min_x = info.minimum;
+            m_evdev.abs_max_x = info.maximum;
+        }
+        if (ioctl(fd, EVIOCGABS(ABS_Y), &info) == 0) {
+            m_evdev.abs_min_y = info.minimum;
+            m_evdev.abs_max_y = info.maximum;
+        }
+
+        if (!open_fd(fd, &read_evdev, nullptr)) {
+            ::close(fd);
+            return false;
+        }
+        m_owns_src = true;
+        return true;
+    }
+
+    /// Stop the reader thread and close an owned source
+    void close() noexcept {
+        if (m_reader.joinable()) {
+            uint64_t one = 1;
+            [[maybe_unused]] auto n = ::write(m_stop_fd, &one, sizeof(one));
+            m_reader.join();
+            uint64_t count;
+            [[maybe_unused]] auto r = ::read(m_stop_fd, &count, sizeof(count));
+        }
+        if (m_owns_src && m_src_fd >= 0) {
+            ::close(m_src_fd);
+        }
+        m_src_fd = -1;
+        m_owns_src = false;
+        m_read_fn = nullptr;
+    }
+
+private:
+    void reader_loop() noexcept {
+        pollfd fds[2] = {{m_src_fd, POLLIN, 0}, {m_stop_fd, POLLIN, 0}};
+        while (true) {
+            if (::poll(fds, 2, -1) < 0) {
+                continue;  // EINTR
+            }
+            if (fds[1].revents & POLLIN) {
+                return;
+            }
+            if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                return;
+            }
+            if ((fds[0].revents & POLLIN) && !m_read_fn(m_src_fd, *this, m_read_ctx)) {
+                return;
+            }
+        }
+    }
+
+    static int32_t map_axis(int32_t v, int32_t min, int32_t max, int32_t res) noexcept {
+        if (max <= min || res <= 0) return v;
+        return static_cast<int32_t>((static_cast<int64_t>(v - min) * (res - 1)) / (max - min));
+    }
+
+    static uint32_t map_key(uint16_t code) noexcept {
+        switch (code) {
+            case KEY_UP:        return LV_KEY_UP;
+            case KEY_DOWN:      return LV_KEY_DOWN;
+            case KEY_LEFT:      return LV_KEY_LEFT;
+            case KEY_RIGHT:     return LV_KEY_RIGHT;
+            case KEY_ENTER:     return LV_KEY_ENTER;
+            case KEY_ESC:       return LV_KEY_ESC;
+            case KEY_BACKSPACE: return LV_KEY_BACKSPACE;
+            case KEY_DELETE:    return LV_KEY_DEL;
+            case KEY_TAB:       return LV_KEY_NEXT;
+            case KEY_HOME:      return LV_KEY_HOME;
+            case KEY_END:       return LV_KEY_END;
+            default:            return 0;
+        }
+    }
+
+    static bool read_evdev(int fd, BasicEventIndev& self, void*) noexcept {
+        EvdevState& st = self.m_evdev;
+        input_event ev[16];
+        while (true) {
+            ssize_t n = ::read(fd, ev, sizeof(ev));
+            if (n < 0) {
+                return errno == EAGAIN || errno == EINTR;  // EAGAIN: drained
+            }
+            if (n == 0) {
+                return false;  // Device gone
+            }
+            for (size_t i = 0; i < static_cast<size_t>(n) / sizeof(input_event); ++i) {
+                const input_event& e = ev[i];
+                switch (e.type) {
+                    case EV_ABS:
+                        if (e.code == ABS_X || e.code == ABS_MT_POSITION_X) {
+                            st.pending.point.x = map_axis(e.value, st.abs_min_x, st.abs_max_x, st.hor_res);
+                        } else if (e.code == ABS_Y || e.code == ABS_MT_POSITION_Y) {
+                            st.pending.point.y = map_axis(e.value, st.abs_min_y, st.abs_max_y, st.ver_res);
+                        }
+                        st.dirty = true;
+                        break;
+                    case EV_REL:
+                        if (e.code == REL_X) {
+                            st.pending.point.x = LV_CLAMP(0, st.pending.point.x + e.value, st.hor_res - 1);
+                        } else if (e.code == REL_Y) {
+                            st.pending.point.y = LV_CLAMP(0, st.pending.point.y + e.value, st.ver_res - 1);
+                        } else if (e.code == REL_WHEEL) {
+                            st.pending.enc_diff = static_cast<int16_t>(st.pending.enc_diff - e.value);
+                        }
+                        st.dirty = true;
+                        break;
+                    case EV_KEY:
+                        if (e.code == BTN_TOUCH || e.code == BTN_LEFT || e.code == BTN_MOUSE) {
+                            st.pending.state = e.value ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+                        } else if (uint32_t k = map_key(e.code)) {
+                            st.pending.key = k;
+                            st.pending.state = e.value ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+                        }
+                        st.dirty = true;
+                        break;
+                    case EV_SYN:
+                        if (e.code == SYN_REPORT && st.dirty) {
+                            st.pending.time_ms = 0;
+                            self.push(st.pending);
+                            st.pending.enc_diff = 0;
+                            st.dirty = false;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+#endif
+};
+
+/// Event-driven input device with the default 64-sample queue
+using EventIndev = BasicEventIndev<64>;
+
+} // namespace lv
@@ -0,0 +1,208 @@
+#pragma once
+
+/**
+ * @file event_table.hpp
+ * @brief Per-object event dispatch table with a single LVGL descriptor
+ *
+ * Every lv_obj_add_event_cb() call appends a descriptor to the object, and
+ * LVGL walks the whole list for every event it sends, including frequent
+ * ones like draw_main, cover_check and pressing. A widget with handlers for
+ * clicked, pressed, value_changed and scroll therefore pays four descriptor
+ * checks on each draw event.
+ *
+ * EventTable installs ONE LV_EVENT_ALL descriptor per object and keeps the
+ * handlers in a compact array sorted by event code. A 64-bit mask of the
+ * registered codes rejects uninteresting events with a single AND, and
+ * matching handlers are found with a binary search.
+ *
+ * Usually used through EventMixin::route():
+ * @code
+ * lv::Slider(parent)
+ *     .route<&App::on_changed>(lv::kEvent::value_changed, this)
+ *     .route<&App::on_pressed>(lv::kEvent::pressed, this)
+ *     .route(lv::kEvent::released, [](lv::Event e) { ... });
+ * @endcode
+ *
+ * The table is allocated with lv_malloc() on first use and freed when the
+ * object is deleted.
+ *
+ * @note Handlers receive their own user_data as a second argument;
+ * lv_event_get_user_data() inside a routed handler returns the table.
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include "object.hpp"
+
+namespace lv {
+
+/// Routed handler: event plus the user_data given at registration
+using RoutedEventCb = void (*)(lv_event_t* e, void* user_data);
+
+/**
+ * @brief Sorted event-code → handler table attached to one object
+ */
+class EventTable {
+    struct Entry {
+        uint32_t code;
+        RoutedEventCb cb;
+        void* user_data;
+    };
+
+    static constexpr uint32_t MASK_BITS = 64;
+    static constexpr uint64_t HIGH_CODES = 1ull << (MASK_BITS - 1);  ///< Any code >= 63 registered
+
+    uint64_t m_mask = 0;
+    uint16_t m_count = 0;
+    uint16_t m_capacity = 0;
+    uint8_t m_depth = 0;       ///< Nested dispatches (a handler sending events to the object)
+    bool m_deleted = false;    ///< Object deleted; freed when the outermost dispatch returns
+    Entry* m_entries = nullptr;
+
+    [[nodiscard]] static uint64_t bit(uint32_t code) noexcept {
+        return code < MASK_BITS - 1 ? (1ull << code) : HIGH_CODES;
+    }
+
+    /// Index of the first entry with entry.code >= code
+    [[nodiscard]] uint16_t lower_bound(uint32_t code) const noexcept {
+        uint16_t lo = 0;
+        uint16_t hi = m_count;
+        while (lo < hi) {
+            uint16_t mid = static_cast<uint16_t>((lo + hi) / 2);
+            if (m_entries[mid].code < code) lo = static_cast<uint16_t>(mid + 1);
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    bool reserve(uint16_t capacity) noexcept {
+        if (capacity <= m_capacity) return true;
+        auto* entries = static_cast<Entry*>(lv_realloc(m_entries, sizeof(Entry) * capacity));
+        if (!entries) return false;
+        m_entries = entries;
+        m_capacity = capacity;
+        return true;
+    }
+
+    void dispatch(lv_event_t* e, uint32_t code) noexcept {
+        if (!(m_mask & bit(code))) return;
+        // Index-based so a handler that adds routes (realloc) can't leave a dangling pointer
+        for (uint16_t i = lower_bound(code); i < m_count && m_entries[i].code == code; ++i) {
+            m_entries[i].cb(e, m_entries[i].user_data);
+            if (m_deleted) break;   // The handler deleted the object
+        }
+    }
+
+    static void trampoline(lv_event_t* e) {
+        auto* table = static_cast<EventTable*>(lv_event_get_user_data(e));
+        const uint32_t code = static_cast<uint32_t>(lv_event_get_code(e));
+        ++table->m_depth;
+        table->dispatch(e, code);
+        --table->m_depth;
+        if (code == LV_EVENT_DELETE) table->m_deleted = true;
+        // A handler deleting its object runs DELETE nested: the outer dispatch frees
+        if (table->m_deleted && table->m_depth == 0) {
+            table->~EventTable();
+            lv_free(table);
+        }
+    }
+
+    EventTable() noexcept = default;
+
+public:
+    ~EventTable() {
+        if (m_entries) lv_free(m_entries);
+    }
+
+    EventTable(const EventTable&) = delete;
+    EventTable& operator=(const EventTable&) = delete;
+
+    /// Find the table attached to obj, or nullptr
+    [[nodiscard]] static EventTable* find(lv_obj_t* obj) noexcept {
+        const uint32_t n = lv_obj_get_event_count(obj);
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_event_dsc_t* dsc = lv_obj_get_event_dsc(obj, i);
+            if (lv_event_dsc_get_cb(dsc) == &trampoline) {
+                return static_cast<EventTable*>(lv_event_dsc_get_user_data(dsc));
+            }
+        }
+        return nullptr;
+    }
+
+    /// Get the table attached to obj, creating it on first use
+    [[nodiscard]] static EventTable* of(lv_obj_t* obj) noexcept {
+        if (EventTable* table = find(obj)) return table;
+        void* mem = lv_malloc(sizeof(EventTable));
+        if (!mem) return nullptr;
+        auto* table = new (mem) EventTable();
+        lv_obj_add_event_cb(obj, &trampoline, LV_EVENT_ALL, table);
+        return table;
+    }
+
+    /**
+     * @brief Register a handler for an event code
+     *
+     * Handlers for the same code run in registration order.
+     */
+    bool add(lv_event_code_t code, RoutedEventCb cb, void* user_data = nullptr) noexcept {
+        const auto c = static_cast<uint32_t>(code);
+        if (m_count == m_capacity &&
+            !reserve(static_cast<uint16_t>(m_capacity ? m_capacity * 2 : 4))) {
+            return false;
+        }
+        // Insert after existing entries with the same code (stable)
+        uint16_t pos = lower_bound(c + 1);
+        std::memmove(&m_entries[pos + 1], &m_entries[pos], sizeof(Entry) * (m_count - pos));
+        m_entries[pos] = {c, cb, user_data};
+        ++m_count;
+        m_mask |= bit(c);
+        return true;
+    }
+
+    /**
+     * @brief Remove handlers matching code, cb and user_data
+     *
+     * @return Number of handlers removed
+     */
+    uint32_t remove(lv_event_code_t code, RoutedEventCb cb, void* user_data = nullptr) noexcept {
+        const auto c = static_cast<uint32_t>(code);
+        uint32_t removed = 0;
+        for (uint16_t i = lower_bound(c); i < m_count && m_entries[i].code == c;) {
+            if (m_entries[i].cb == cb && m_entries[i].user_data == user_data) {
+                std::memmove(&m_entries[i], &m_entries[i + 1], sizeof(Entry) * (m_count - i - 1));
+                --m_count;
+                ++removed;
+            } else {
+                ++i;
+            }
+        }
+        // Rebuild the mask
+        m_mask = 0;
+        for (uint16_t i = 0; i < m_count; ++i) m_mask |= bit(m_entries[i].code);
+        return removed;
+    }
+
+    /// Check if exactly this handler is registered for code
+    [[nodiscard]] bool contains(lv_event_code_t code, RoutedEventCb cb, void* user_data = nullptr) const noexcept {
+        const auto c = static_cast<uint32_t>(code);
+        for (uint16_t i = lower_bound(c); i < m_count && m_entries[i].code == c; ++i) {
+            if (m_entries[i].cb == cb && m_entries[i].user_data == user_data) return true;
+        }
+        return false;
+    }
+
+    /// Number of registered handlers
+    [[nodiscard]] uint32_t size() const noexcept { return m_count; }
+
+    /// Check if any handler is registered for code
+    [[nodiscard]] bool has(lv_event_code_t code) const noexcept {
+        const auto c = static_cast<uint32_t>(code);
+        if (!(m_mask & bit(c))) return false;
+        uint16_t i = lower_bound(c);
+        return i < m_count && m_entries[i].code == c;
+    }
+};
+
+} // namespace lv
@@ -0,0 +1,281 @@
+#pragma once
+
+/**
+ * @file flush_filter.hpp
+ * @brief Drop flushes that would not change what the panel shows
+ *
+ * Periodic timers (a clock hand every 100 ms, an animation tick) often set
+ * values that are already shown; the widget still invalidates, LVGL
+ * renders the same pixels again and the driver sends them over SPI or to
+ * an e-paper controller. FlushFilter wraps the display's flush_cb and
+ * hashes every flushed area. If the same area was last sent with the same
+ * hash, and nothing overlapping was sent since, the panel already shows it:
+ * the flush is completed without calling the driver.
+ *
+ * @code
+ * lv::FlushFilter filter(display);
+ * // ...
+ * filter.log();    // Frames and bytes that never reached the panel
+ * filter.reset();  // After the panel lost its contents (power cycle)
+ * @endcode
+ *
+ * The hash is one read of the area, much cheaper than a bus transfer but
+ * not free on memory-mapped framebuffers. The last flush of a frame still
+ * goes to the driver if an earlier one did, as drivers may commit on it.
+ * Double-buffered direct and full modes are not supported: the driver must
+ * flip buffers on every frame LVGL renders.
+ */
+
+#include <lvgl.h>
+#include <src/display/lv_display_private.h>   // flush_cb, render_mode, buf_2
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+namespace lv {
+
+/// FlushFilter statistics
+struct FlushFilterStats {
+    uint32_t frames = 0;             ///< Refreshes that flushed something
+    uint32_t suppressed_frames = 0;  ///< Refreshes with every flush dropped
+    uint32_t flushes = 0;            ///< flush_cb calls from LVGL
+    uint32_t suppressed = 0;         ///< Flushes dropped
+    uint64_t bytes_saved = 0;        ///< Pixel bytes not sent
+    uint64_t hash_us = 0;            ///< Time spent hashing
+};
+
+namespace detail {
+
+/// Hash rows of pixel data, 8 bytes per step
+[[nodiscard]] inline uint64_t flush_hash(const uint8_t* p, uint32_t row_bytes, uint32_t stride,
+                                         int32_t rows, uint64_t h) noexcept {
+    constexpr uint64_t K = 0x9E3779B97F4A7C15ull;
+    for (int32_t y = 0; y < rows; ++y, p += stride) {
+        uint32_t i = 0;
+        for (; i + 8 <= row_bytes; i += 8) {
+            uint64_t w;
+            std::memcpy(&w, p + i, 8);
+            h = std::rotl(h ^ w, 31) * K;
+        }
+        for (; i < row_bytes; ++i) h = std::rotl(h ^ p[i], 31) * K;
+    }
+    return h ^ (h >> 29);
+}
+
+/**
+ * @brief What the panel shows: the last hash sent for up to N areas (LRU)
+ *
+ * An area is known only while nothing overlapping was sent after it.
+ */
+template<uint32_t N>
+class ShownAreas {
+    struct Slot {
+        lv_area_t area;
+        uint64_t hash;
+        uint32_t used;   ///< 0 = empty
+    };
+
+    Slot m_slots[N] = {};
+    uint32_t m_clock = 0;
+
+public:
+    /// Check if the panel shows exactly this area with this hash
+    [[nodiscard]] bool shows(const lv_area_t& area, uint64_t hash) noexcept {
+        for (Slot& s : m_slots) {
+            if (s.used && lv_area_is_equal(&s.area, &area)) {
+                if (s.hash != hash) return false;
+                s.used = ++m_clock;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Record that area is sent with hash
+    void sent(const lv_area_t& area, uint64_t hash) noexcept {
+        Slot* same = nullptr;
+        for (Slot& s : m_slots) {
+            if (s.used && lv_area_is_equal(&s.area, &area)) same = &s;
+        }
+        // What the panel shows under other remembered areas is about to change
+        for (Slot& s : m_slots) {
+            if (&s != same && s.used && lv_area_is_on(&s.area, &area)) s.used = 0;
+        }
+        if (!same) {
+            same = &m_slots[0];
+            for (Slot& s : m_slots) {
+                if (s.used < same->used) same = &s;
+            }
+        }
+        *same = {area, hash, ++m_clock};
+    }
+
+    /// Forget everything
+    void clear() noexcept {
+        for (Slot& s : m_slots) s.used = 0;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Flush stage that skips unchanged areas
+ *
+ * Wraps the display's flush_cb; the destructor restores it. Non-movable
+ * (found through the display's event list).
+ */
+class FlushFilter {
+public:
+    /// Areas remembered (LRU)
+    static constexpr uint32_t SLOTS = 32;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    lv_display_t* m_display = nullptr;
+    lv_display_flush_cb_t m_sink = nullptr;
+    detail::ShownAreas<SLOTS> m_shown;
+    uint32_t m_frame_flushes = 0;
+    uint32_t m_frame_passed = 0;
+    FlushFilterStats m_stats;
+
+    static void event_cb(lv_event_t* e) {
+        auto* self = static_cast<FlushFilter*>(lv_event_get_user_data(e));
+        switch (lv_event_get_code(e)) {
+        case LV_EVENT_REFR_START:
+            self->m_frame_flushes = 0;
+            self->m_frame_passed = 0;
+            break;
+        case LV_EVENT_REFR_READY:
+            if (self->m_frame_flushes) {
+                ++self->m_stats.frames;
+                if (!self->m_frame_passed) ++self->m_stats.suppressed_frames;
+            }
+            break;
+        case LV_EVENT_DELETE:
+            self->m_display = nullptr;
+            break;
+        default:
+            break;
+        }
+    }
+
+    [[nodiscard]] static FlushFilter* find(lv_display_t* disp) noexcept {
+        const uint32_t n = lv_display_get_event_count(disp);
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_event_dsc_t* dsc = lv_display_get_event_dsc(disp, i);
+            if (lv_event_dsc_get_cb(dsc) == &event_cb) {
+                return static_cast<FlushFilter*>(lv_event_dsc_get_user_data(dsc));
+            }
+        }
+        return nullptr;
+    }
+
+    static void flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
+        FlushFilter* self = find(disp);
+        if (!self) {
+            lv_display_flush_ready(disp);
+            return;
+        }
+        self->filter(*area, px_map);
+    }
+
+    void filter(const lv_area_t& area, uint8_t* px_map) noexcept {
+        const auto t0 = Clock::now();
+        const lv_color_format_t cf = lv_display_get_color_format(m_display);
+        const int32_t w = lv_area_get_width(&area);
+        const int32_t h = lv_area_get_height(&area);
+        const uint32_t px_size = lv_color_format_get_size(cf);
+
+        // Partial: px_map holds just the area; direct/full: the whole screen
+        const uint8_t* src = px_map;
+        uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
+        if (m_display->render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) {
+            stride = lv_draw_buf_width_to_stride(lv_display_get_horizontal_resolution(m_display), cf);
+            src += area.y1 * stride + area.x1 * px_size;
+        }
+        const uint64_t seed = (static_cast<uint64_t>(static_cast<uint32_t>(w)) << 32) | static_cast<uint32_t>(h);
+        const uint64_t hash = detail::flush_hash(src, static_cast<uint32_t>(w) * px_size, stride, h, seed);
+        m_stats.hash_us += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count());
+
+        ++m_stats.flushes;
+        ++m_frame_flushes;
+
+        const bool must_send = m_frame_passed && lv_display_flush_is_last(m_display);
+        if (!must_send && m_shown.shows(area, hash)) {
+            ++m_stats.suppressed;
+            m_stats.bytes_saved += static_cast<uint64_t>(w) * static_cast<uint64_t>(h) * px_size;
+            lv_display_flush_ready(m_display);
+            return;
+        }
+        m_shown.sent(area, hash);
+
+        ++m_frame_passed;
+        m_sink(m_display, &area, px_map);
+    }
+
+public:
+    /**
+     * @brief Insert the filter in front of the display's flush_cb
+     *
+     * @param display Display to wrap (nullptr = default display)
+     */
+    explicit FlushFilter(lv_display_t* display = nullptr) noexcept {
+        if (!display) display = lv_display_get_default();
+        if (!display || !display->flush_cb) {
+            LV_LOG_WARN("FlushFilter: display has no flush_cb");
+            return;
+        }
+        if (display->buf_2 && display->render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) {
+            LV_LOG_WARN("FlushFilter: double-buffered direct/full mode not supported");
+            return;
+        }
+        m_display = display;
+        m_sink = display->flush_cb;
+        lv_display_add_event_cb(display, &event_cb, LV_EVENT_DELETE, this);
+        lv_display_add_event_cb(display, &event_cb, LV_EVENT_REFR_START, this);
+        lv_display_add_event_cb(display, &event_cb, LV_EVENT_REFR_READY, this);
+        lv_display_set_flush_cb(display, &flush_cb);
+    }
+
+    /// Give the display its flush_cb back
+    ~FlushFilter() {
+        if (m_display) {
+            lv_display_remove_event_cb_with_user_data(m_display, &event_cb, this);
+            lv_display_set_flush_cb(m_display, m_sink);
+        }
+    }
+
+    FlushFilter(const FlushFilter&) = delete;
+    FlushFilter& operator=(const FlushFilter&) = delete;
+
+    /// Check if the filter is installed
+    [[nodiscard]] bool active() const noexcept { return m_display != nullptr; }
+
+    /// Forget what the panel shows (the next flush of every area goes through)
+    FlushFilter& reset() noexcept {
+        m_shown.clear();
+        return *this;
+    }
+
+    /// Filter statistics
+    [[nodiscard]] const FlushFilterStats& stats() const noexcept { return m_stats; }
+
+    /// Reset the statistics
+    FlushFilter& reset_stats() noexcept {
+        m_stats = {};
+        return *this;
+    }
+
+    /// Print statistics with LV_LOG_USER
+    void log() const noexcept {
+        LV_LOG_USER("FlushFilter: frames=%u suppressed=%u, flushes=%u suppressed=%u, saved %uKB, hashing %ums",
+                    static_cast<unsigned>(m_stats.frames), static_cast<unsigned>(m_stats.suppressed_frames),
+                    static_cast<unsigned>(m_stats.flushes), static_cast<unsigned>(m_stats.suppressed),
+                    static_cast<unsigned>(m_stats.bytes_saved / 1024), static_cast<unsigned>(m_stats.hash_us / 1000));
+    }
+};
+
+} // namespace lv
@@ -0,0 +1,355 @@
+#pragma once
+
+/**
+ * @file flush_transform.hpp
+ * @brief Rotation, byte swap and format conversion fused into one flush pass
+ *
+ * A rotated RGB565 SPI panel normally costs two extra passes per flushed
+ * area: lv_draw_sw_rotate() into a second buffer, then
+ * lv_draw_sw_rgb565_swap() or a format conversion. FlushTransform wraps
+ * the display's flush_cb and does both in one pass:
+ *
+ * - Each pixel is read once in LVGL's render format and written once, rotated
+ *   and converted, into a scratch buffer that goes to the original flush_cb
+ *   with the physical area
+ * - 90/270 degrees are processed in 16 x 16 blocks so reads and writes stay
+ *   in cache
+ * - Unrotated XRGB8888 -> RGB565 rows use SSE2/NEON
+ *
+ * @code
+ * lv::FlushTransform xf(display, LV_DISPLAY_ROTATION_90, LV_COLOR_FORMAT_RGB565, true);  // Swapped RGB565
+ * xf.rotation(LV_DISPLAY_ROTATION_270);   // Re-lays out the UI
+ * @endcode
+ *
+ * The rotation is applied with lv_display_set_rotation(), so LVGL lays out
+ * in the rotated resolution; the pixel mapping matches lv_draw_sw_rotate()
+ * and lv_display_rotate_area(). Render formats: XRGB8888, ARGB8888,
+ * RGB888, RGB565. Output formats: RGB565, RGB888, XRGB8888.
+ *
+ * Partial render mode only: the original flush_cb receives a packed buffer
+ * (stride = width x output pixel size) holding just the physical area.
+ * While it runs the display reports LV_DISPLAY_ROTATION_0, so backends that
+ * rotate on their own (lv_draw_sw_rotate()) do not rotate a second time.
+ */
+
+#include <lvgl.h>
+#include <src/display/lv_display_private.h>   // flush_cb, render_mode, rotation
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace lv {
+
+namespace detail {
+
+/// Pixel formats handled by FlushTransform (bytes per pixel in the value)
+enum class XfFormat : uint8_t { rgb565 = 2, rgb888 = 3, xrgb8888 = 4 };
+
+template<XfFormat F>
+[[nodiscard]] inline uint32_t xf_read(const uint8_t* p) noexcept {
+    if constexpr (F == XfFormat::rgb565) {
+        const uint32_t c = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8);
+        const uint32_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+        return ((r << 3 | r >> 2) << 16) | ((g << 2 | g >> 4) << 8) | (b << 3 | b >> 2);
+    } else {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16);
+    }
+}
+
+template<XfFormat F, bool Swap>
+inline void xf_write(uint8_t* p, uint32_t c) noexcept {
+    if constexpr (F == XfFormat::rgb565) {
+        const uint32_t v = ((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F);
+        p[Swap ? 1 : 0] = static_cast<uint8_t>(v);
+        p[Swap ? 0 : 1] = static_cast<uint8_t>(v >> 8);
+    } else {
+        p[0] = static_cast<uint8_t>(c);
+        p[1] = static_cast<uint8_t>(c >> 8);
+        p[2] = static_cast<uint8_t>(c >> 16);
+        if constexpr (F == XfFormat::xrgb8888) p[3] = 0xFF;
+    }
+}
+
+/// Convert one unrotated row; returns the pixels done with SIMD
+template<XfFormat In, XfFormat Out, bool Swap>
+inline int32_t xf_row_simd(const uint8_t* src, uint8_t* dst, int32_t w) noexcept {
+    int32_t x = 0;
+    if constexpr (In == XfFormat::xrgb8888 && Out == XfFormat::rgb565) {
+#if defined(__SSE2__)
+        const __m128i mr = _mm_set1_epi32(0xF800), mg = _mm_set1_epi32(0x07E0), mb = _mm_set1_epi32(0x001F);
+        const __m128i bias = _mm_set1_epi32(0x8000), unbias = _mm_set1_epi16(static_cast<short>(0x8000));
+        for (; x + 8 <= w; x += 8) {
+            __m128i v[2];
+            for (int i = 0; i < 2; ++i) {
+                const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (x + i * 4) * 4));
+                const __m128i c = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 8), mr),
+                                                            _mm_and_si128(_mm_srli_epi32(p, 5), mg)),
+                                               _mm_and_si128(_mm_srli_epi32(p, 3), mb));
+                v[i] = _mm_sub_epi32(c, bias);   // packs_epi32 saturates signed
+            }
+            __m128i o = _mm_xor_si128(_mm_packs_epi32(v[0], v[1]), unbias);
+            if constexpr (Swap) o = _mm_or_si128(_mm_slli_epi16(o, 8), _mm_srli_epi16(o, 8));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2), o);
+        }
+#elif defined(__ARM_NEON)
+        for (; x + 8 <= w; x += 8) {
+            const uint8x8x4_t p = vld4_u8(src + x * 4);   // b, g, r, a
+            uint16x8_t o = vshll_n_u8(p.val[2], 8);
+            o = vsriq_n_u16(o, vshll_n_u8(p.val[1], 8), 5);
+            o = vsriq_n_u16(o, vshll_n_u8(p.val[0], 8), 11);
+            uint8x16_t bytes = vreinterpretq_u8_u16(o);
+            if constexpr (Swap) bytes = vrev16q_u8(bytes);
+            vst1q_u8(dst + x * 2, bytes);
+        }
+#endif
+    }
+    (void)src;
+    (void)dst;
+    (void)w;
+    return x;
+}
+
+/**
+ * @brief Rotate and convert w x h pixels
+ *
+ * Destination pixel of source (x, y), as lv_draw_sw_rotate():
+ * 90: (y, w-1-x), 180: (w-1-x, h-1-y), 270: (h-1-y, x)
+ */
+template<XfFormat In, XfFormat Out, bool Swap>
+inline void xf_transform(const uint8_t* src, uint32_t src_stride, int32_t w, int32_t h,
+                         uint8_t* dst, uint32_t dst_stride, lv_display_rotation_t rot) noexcept {
+    constexpr int32_t ib = static_cast<int32_t>(In);
+    constexpr int32_t ob = static_cast<int32_t>(Out);
+    constexpr int32_t B = 16;
+
+    if (rot == LV_DISPLAY_ROTATION_0 || rot == LV_DISPLAY_ROTATION_180) {
+        const bool flip = rot == LV_DISPLAY_ROTATION_180;
+        for (int32_t y = 0; y < h; ++y) {
+            const uint8_t* s = src + y * src_stride;
+            uint8_t* d = dst + (flip ? h - 1 - y : y) * dst_stride;
+            if (!flip) {
+                if constexpr (In == Out && !Swap) {
+                    std::memcpy(d, s, static_cast<size_t>(w) * ib);
+                    continue;
+                }
+                for (int32_t x = xf_row_simd<In, Out, Swap>(s, d, w); x < w; ++x) {
+                    xf_write<Out, Swap>(d + x * ob, xf_read<In>(s + x * ib));
+                }
+            } else {
+                for (int32_t x = 0; x < w; ++x) {
+                    xf_write<Out, Swap>(d + (w - 1 - x) * ob, xf_read<In>(s + x * ib));
+                }
+            }
+        }
+        return;
+    }
+
+    const bool cw270 = rot == LV_DISPLAY_ROTATION_270;
+    for (int32_t by = 0; by < h; by += B) {
+        const int32_t ey = LV_MIN(by + B, h);
+        for (int32_t bx = 0; bx < w; bx += B) {
+            const int32_t ex = LV_MIN(bx + B, w);
+            for (int32_t y = by; y < ey; ++y) {
+                const uint8_t* s = src + y * src_stride;
+                const int32_t col = cw270 ? h - 1 - y : y;
+                for (int32_t x = bx; x < ex; ++x) {
+                    const int32_t row = cw270 ? x : w - 1 - x;
+                    xf_write<Out, Swap>(dst + row * dst_stride + col * ob, xf_read<In>(s + x * ib));
+                }
+            }
+        }
+    }
+}
+
+using XfKernel = void (*)(const uint8_t*, uint32_t, int32_t, int32_t, uint8_t*, uint32_t, lv_display_rotation_t);
+
+template<XfFormat In>
+[[nodiscard]] inline XfKernel xf_pick_out(XfFormat out, bool swap) noexcept {
+    switch (out) {
+    case XfFormat::rgb565:
+        return swap ? &xf_transform<In, XfFormat::rgb565, true> : &xf_transform<In, XfFormat::rgb565, false>;
+    case XfFormat::rgb888:
+        return &xf_transform<In, XfFormat::rgb888, false>;
+    case XfFormat::xrgb8888:
+        return &xf_transform<In, XfFormat::xrgb8888, false>;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline bool xf_format(lv_color_format_t cf, XfFormat& out) noexcept {
+    switch (cf) {
+    case LV_COLOR_FORMAT_RGB565: out = XfFormat::rgb565; return true;
+    case LV_COLOR_FORMAT_RGB888: out = XfFormat::rgb888; return true;
+    case LV_COLOR_FORMAT_XRGB8888:
+    case LV_COLOR_FORMAT_ARGB8888: out = XfFormat::xrgb8888; return true;
+    default: return false;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Flush stage that rotates and converts in a single pass
+ *
+ * Wraps the display's flush_cb; the destructor restores it and the
+ * rotation. Non-movable (found through the display's event list).
+ */
+class FlushTransform {
+    lv_display_t* m_display = nullptr;
+    lv_display_flush_cb_t m_sink = nullptr;
+    detail::XfKernel m_kernel = nullptr;
+    detail::XfFormat m_in = detail::XfFormat::xrgb8888;
+    detail::XfFormat m_out = detail::XfFormat::xrgb8888;
+    lv_display_rotation_t m_saved_rotation = LV_DISPLAY_ROTATION_0;
+
+    uint8_t* m_buf = nullptr;
+    uint32_t m_buf_size = 0;
+
+    static void event_cb(lv_event_t* e) {
+        static_cast<FlushTransform*>(lv_event_get_user_data(e))->m_display = nullptr;   // Display deleted
+    }
+
+    [[nodiscard]] static FlushTransform* find(lv_display_t* disp) noexcept {
+        const uint32_t n = lv_display_get_event_count(disp);
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_event_dsc_t* dsc = lv_display_get_event_dsc(disp, i);
+            if (lv_event_dsc_get_cb(dsc) == &event_cb) {
+                return static_cast<FlushTransform*>(lv_event_dsc_get_user_data(dsc));
+            }
+        }
+        return nullptr;
+    }
+
+    static void flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
+        FlushTransform* self = find(disp);
+        if (!self) {
+            lv_display_flush_ready(disp);
+            return;
+        }
+        self->transform(*area, px_map);
+    }
+
+    void transform(const lv_area_t& area, const uint8_t* px_map) noexcept {
+        const int32_t w = lv_area_get_width(&area);
+        const int32_t h = lv_area_get_height(&area);
+        const uint32_t ob = static_cast<uint32_t>(m_out);
+        const uint32_t bytes = static_cast<uint32_t>(w * h) * ob;
+        if (bytes > m_buf_size) {
+            lv_free(m_buf);
+            m_buf = static_cast<uint8_t*>(lv_malloc(bytes));
+            m_buf_size = m_buf ? bytes : 0;
+            if (!m_buf) {
+                LV_LOG_WARN("FlushTransform: out of memory");
+                lv_display_flush_ready(m_display);
+                return;
+            }
+        }
+
+        // Partial mode: px_map holds just the area
+        const uint32_t src_stride = lv_draw_buf_width_to_stride(w, lv_display_get_color_format(m_display));
+        const lv_display_rotation_t rot = lv_display_get_rotation(m_display);
+        const bool quarter = rot == LV_DISPLAY_ROTATION_90 || rot == LV_DISPLAY_ROTATION_270;
+        const uint32_t dst_stride = static_cast<uint32_t>(quarter ? h : w) * ob;
+        m_kernel(px_map, src_stride, w, h, m_buf, dst_stride, rot);
+
+        // Physical area, as lv_display_rotate_area()
+        const int32_t phys_w = lv_display_get_physical_horizontal_resolution(m_display);
+        const int32_t phys_h = lv_display_get_physical_vertical_resolution(m_display);
+        lv_area_t out = area;
+        switch (rot) {
+        case LV_DISPLAY_ROTATION_90:
+            out = {area.y1, phys_h - 1 - area.x2, area.y2, phys_h - 1 - area.x1};
+            break;
+        case LV_DISPLAY_ROTATION_180:
+            out = {phys_w - 1 - area.x2, phys_h - 1 - area.y2, phys_w - 1 - area.x1, phys_h - 1 - area.y1};
+            break;
+        case LV_DISPLAY_ROTATION_270:
+            out = {phys_w - 1 - area.y2, area.x1, phys_w - 1 - area.y1, area.x2};
+            break;
+        default:
+            break;
+        }
+
+        // The pixels are physical now: hide the rotation from the backend
+        // (set directly, lv_display_set_rotation() would re-lay out)
+        m_display->rotation = LV_DISPLAY_ROTATION_0;
+        m_sink(m_display, &out, m_buf);
+        m_display->rotation = rot;
+    }
+
+public:
+    /**
+     * @brief Insert the transform in front of the display's flush_cb
+     *
+     * @param display Display to wrap
+     * @param rotation Rotation LVGL lays out for (the panel stays unrotated)
+     * @param out Output format (LV_COLOR_FORMAT_UNKNOWN = the render format)
+     * @param swap_bytes Swap the bytes of RGB565 output (SPI panels)
+     */
+    explicit FlushTransform(lv_display_t* display,
+                            lv_display_rotation_t rotation = LV_DISPLAY_ROTATION_0,
+                            lv_color_format_t out = LV_COLOR_FORMAT_UNKNOWN,
+                            bool swap_bytes = false) noexcept {
+        if (!display || !display->flush_cb) {
+            LV_LOG_WARN("FlushTransform: display has no flush_cb");
+            return;
+        }
+        if (display->render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) {
+            LV_LOG_WARN("FlushTransform: needs partial render mode");
+            return;
+        }
+        const lv_color_format_t in = lv_display_get_color_format(display);
+        if (out == LV_COLOR_FORMAT_UNKNOWN) out = in;
+        if (!detail::xf_format(in, m_in) || !detail::xf_format(out, m_out)) {
+            LV_LOG_WARN("FlushTransform: unsupported color format");
+            return;
+        }
+        switch (m_in) {
+        case detail::XfFormat::rgb565: m_kernel = detail::xf_pick_out<detail::XfFormat::rgb565>(m_out, swap_bytes); break;
+        case detail::XfFormat::rgb888: m_kernel = detail::xf_pick_out<detail::XfFormat::rgb888>(m_out, swap_bytes); break;
+        case detail::XfFormat::xrgb8888: m_kernel = detail::xf_pick_out<detail::XfFormat::xrgb8888>(m_out, swap_bytes); break;
+        }
+
+        m_display = display;
+        m_sink = display->flush_cb;
+        m_saved_rotation = lv_display_get_rotation(display);
+        lv_display_add_event_cb(display, &event_cb, LV_EVENT_DELETE, this);
+        lv_display_set_flush_cb(display, &flush_cb);
+        lv_display_set_rotation(display, rotation);
+    }
+
+    /// Give the display its flush_cb and rotation back
+    ~FlushTransform() {
+        if (m_display) {
+            lv_display_remove_event_cb_with_user_data(m_display, &event_cb, this);
+            lv_display_set_flush_cb(m_display, m_sink);
+            lv_display_set_rotation(m_display, m_saved_rotation);
+        }
+        lv_free(m_buf);
+    }
+
+    FlushTransform(const FlushTransform&) = delete;
+    FlushTransform& operator=(const FlushTransform&) = delete;
+
+    /// Check if the transform is installed
+    [[nodiscard]] bool active() const noexcept { return m_display != nullptr; }
+
+    /// Change the rotation (LVGL re-lays out and redraws)
+    FlushTransform& rotation(lv_display_rotation_t rot) noexcept {
+        if (m_display) lv_display_set_rotation(m_display, rot);
+        return *this;
+    }
+
+    /// Current rotation
+    [[nodiscard]] lv_display_rotation_t rotation() const noexcept {
+        return m_display ? lv_display_get_rotation(m_display) : LV_DISPLAY_ROTATION_0;
+    }
+};
+
+} // namespace lv
@@ -0,0 +1,130 @@
+#pragma once
+
+/**
+ * @file function.hpp
+ * @brief Fixed-capacity, allocation-free type-erased callable
+ *
+ * lv::InplaceFunction<Sig, N> stores any callable whose size is at most N
+ * bytes directly inside the object (small-buffer storage). Unlike
+ * std::function it never allocates: a callable that does not fit is a
+ * compile error, not a silent heap allocation.
+ *
+ * @code
+ * int clicks = 0;
+ * lv::InplaceFunction<void(int), 16> fn = [&clicks](int n) { clicks += n; };
+ * fn(2);
+ * @endcode
+ */
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace lv {
+
+template<typename Sig, size_t N = 4 * sizeof(void*)>
+class InplaceFunction;
+
+/**
+ * @brief Move-only callable with N bytes of inline storage
+ *
+ * @tparam R Return type
+ * @tparam Args Argument types
+ * @tparam N Inline storage size in bytes
+ */
+template<typename R, typename... Args, size_t N>
+class InplaceFunction<R(Args...), N> {
+    struct Ops {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*move)(void* dst, void* src) noexcept;  ///< Move-construct dst from src, destroy src
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template<typename F>
+    static constexpr Ops ops_for{
+        [](void* s, Args&&... args) -> R {
+            return (*static_cast<F*>(s))(std::forward<Args>(args)...);
+        },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* s) noexcept {
+            static_cast<F*>(s)->~F();
+        },
+    };
+
+    alignas(std::max_align_t) unsigned char m_storage[N];
+    const Ops* m_ops = nullptr;
+
+public:
+    /// Inline storage capacity in bytes
+    static constexpr size_t capacity = N;
+
+    /// Check at compile time whether F fits
+    template<typename F>
+    static constexpr bool fits = sizeof(std::decay_t<F>) <= N &&
+                                 alignof(std::decay_t<F>) <= alignof(std::max_align_t) &&
+                                 std::is_nothrow_move_constructible_v<std::decay_t<F>>;
+
+    InplaceFunction() noexcept = default;
+    InplaceFunction(std::nullptr_t) noexcept {}
+
+    /// Store a callable (must fit in N bytes)
+    template<typename F>
+        requires (!std::is_same_v<std::decay_t<F>, InplaceFunction> &&
+                  std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    InplaceFunction(F&& fn) noexcept(std::is_nothrow_constructible_v<std::decay_t<F>, F&&>) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= N,
+            "Callable captures too much for InplaceFunction: capture less "
+            "(e.g. a pointer to a struct) or increase the capacity N");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "Callable is over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "Callable must be nothrow movable");
+        ::new (static_cast<void*>(m_storage)) Fn(std::forward<F>(fn));
+        m_ops = &ops_for<Fn>;
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept : m_ops(other.m_ops) {
+        if (m_ops) {
+            m_ops->move(m_storage, other.m_storage);
+            other.m_ops = nullptr;
+        }
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.m_ops) {
+                other.m_ops->move(m_storage, other.m_storage);
+                m_ops = other.m_ops;
+                other.m_ops = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction() { reset(); }
+
+    /// Destroy the stored callable
+    void reset() noexcept {
+        if (m_ops) {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+    /// Check if a callable is stored
+    [[nodiscard]] explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+    /// Invoke (must not be empty)
+    R operator()(Args... args) {
+        return m_ops->invoke(m_storage, std::forward<Args>(args)...);
+    }
+};
+
+} // namespace lv
@@ -0,0 +1,474 @@
+#pragma once
+
+/**
+ * @file gesture.hpp
+ * @brief Continuous gesture recognition: pan, fling, pinch and rotate
+ *
+ * LVGL's built-in gesture (lv_indev_get_gesture_dir()) only reports a
+ * direction after the finger is lifted. GestureRecognizer keeps a short
+ * history of touch samples and sends typed events while the gesture is in
+ * progress, so animations can follow the finger:
+ *
+ * | Kind | Phases | Payload |
+ * |------|--------|---------|
+ * | pan | begin, update, end | centroid, delta from start, velocity |
+ * | fling | end | release velocity (px/s) |
+ * | pinch | begin, update, end | scale (256 = 1.0, as lv_image scale) |
+ * | rotate | begin, update, end | rotation (0.1°, as lv_image rotation) |
+ *
+ * @code
+ * lv::GestureRecognizer gestures(touch.get());
+ *
+ * card.on(lv::gesture_event(lv::GestureKind::pan), [](lv::Event e) {
+ *     auto* g = e.param_as<lv::GestureInfo>();
+ *     lv_obj_set_x(e.target(), g->delta.x);
+ * });
+ * @endcode
+ *
+ * Events go to the object under the first touch (hit-tested on press) or to
+ * a fixed target(). They are sent after LVGL has processed the indev read,
+ * from LV_EVENT_INDEV_READ of the indev.
+ *
+ * LVGL pointer indevs report a single touch. Pinch and rotate need the
+ * driver to call feed() with all contacts from its read_cb (multi-touch
+ * panels); the tap on the indev then stays out of the way.
+ */
+
+#include <lvgl.h>
+#include "indev_tap.hpp"
+#include <cmath>
+#include <cstdint>
+
+namespace lv {
+
+/// Gesture type (one registered event code each)
+enum class GestureKind : uint8_t {
+    pan,
+    fling,
+    pinch,
+    rotate,
+};
+
+/// Gesture phase
+enum class GesturePhase : uint8_t {
+    begin,
+    update,
+    end,
+};
+
+/// Event parameter of gesture events
+struct GestureInfo {
+    GestureKind kind;
+    GesturePhase phase;
+    uint8_t touches;      ///< Number of contacts
+    lv_point_t point;     ///< Current centroid (screen coordinates)
+    lv_point_t delta;     ///< Centroid movement since the gesture started
+    int32_t vx;           ///< Velocity, px/s
+    int32_t vy;
+    int32_t scale;        ///< Pinch: distance ratio, 256 = unchanged
+    int32_t rotation;     ///< Rotate: angle since start in 0.1°, clockwise positive
+};
+
+/// One contact reported to GestureRecognizer::feed()
+struct TouchPoint {
+    int32_t id;           ///< Stable contact id from the driver
+    lv_point_t point;
+};
+
+/// Recognition thresholds
+struct GestureConfig {
+    int32_t pan_slop = 8;                ///< Movement (px) before a pan begins
+    int32_t fling_min_velocity = 600;    ///< Release speed (px/s) for a fling
+    uint32_t velocity_window_ms = 80;    ///< Samples used for velocity
+    int32_t pinch_slop = 13;             ///< Scale change (1/256) before a pinch begins (~5%)
+    int32_t rotate_slop = 50;            ///< Angle (0.1°) before a rotate begins
+};
+
+/**
+ * @brief Event code for a gesture kind
+ *
+ * Codes are registered with lv_event_register_id() on first use.
+ */
+[[nodiscard]] inline lv_event_code_t gesture_event(GestureKind kind) noexcept {
+    static lv_event_code_t codes[4] = {};
+    auto& code = codes[static_cast<uint8_t>(kind)];
+    if (code == 0) {
+        code = static_cast<lv_event_code_t>(lv_event_register_id());
+    }
+    return code;
+}
+
+/**
+ * @brief Tracks touches and emits gesture events
+ *
+ * Non-movable (registered as indev tap and event callback with `this`).
+ *
+ * @tparam History Number of centroid samples kept for velocity (power of two)
+ */
+template<size_t History = 16>
+class BasicGestureRecognizer {
+    static_assert((History & (History - 1)) == 0 && History >= 2,
+        "History must be a power of two");
+
+    static constexpr uint32_t MAX_PENDING = 8;
+
+    struct Sample {
+        uint32_t time;
+        int32_t x;
+        int32_t y;
+    };
+
+    lv_indev_t* m_indev = nullptr;
+    lv_obj_t* m_fixed_target = nullptr;
+    lv_obj_t* m_target = nullptr;       ///< Receiver of the current gesture
+    GestureConfig m_cfg;
+
+    // Centroid history
+    Sample m_ring[History] = {};
+    uint32_t m_head = 0;
+    uint32_t m_count = 0;
+
+    // Current gesture
+    bool m_down = false;
+    bool m_panning = false;
+    bool m_pinching = false;
+    bool m_rotating = false;
+    bool m_external = false;            ///< feed() drives the state, the tap is ignored
+    uint8_t m_touches = 0;
+    lv_point_t m_origin{};              ///< Start point (rebased when touches change)
+    lv_point_t m_point{};
+    int32_t m_vx = 0;
+    int32_t m_vy = 0;
+
+    // Two-finger baseline
+    int32_t m_ids[2] = {};
+    float m_dist0 = 0;
+    float m_angle0 = 0;
+    int32_t m_scale = LV_SCALE_NONE;
+    int32_t m_rotation = 0;
+
+    GestureInfo m_pending[MAX_PENDING] = {};
+    uint32_t m_pending_count = 0;
+
+    [[nodiscard]] const Sample& at(uint32_t age) const noexcept {
+        return m_ring[(m_head - 1 - age) & (History - 1)];
+    }
+
+    void add_sample(uint32_t t, lv_point_t p) noexcept {
+        if (m_count && at(0).time == t) {
+            m_ring[(m_head - 1) & (History - 1)] = {t, p.x, p.y};
+            return;
+        }
+        m_ring[m_head & (History - 1)] = {t, p.x, p.y};
+        ++m_head;
+        if (m_count < History) ++m_count;
+    }
+
+    /// Velocity between the newest sample and the oldest one inside the window
+    void update_velocity(uint32_t now) noexcept {
+        m_vx = m_vy = 0;
+        if (m_count < 2) return;
+        const Sample& newest = at(0);
+        if (now - newest.time > m_cfg.velocity_window_ms) return;  // Finger rested
+        const Sample* oldest = &at(1);
+        for (uint32_t age = 2; age < m_count; ++age) {
+            const Sample& s = at(age);
+            if (newest.time - s.time > m_cfg.velocity_window_ms) break;
+            oldest = &s;
+        }
+        const int32_t dt = static_cast<int32_t>(newest.time - oldest->time);
+        if (dt <= 0) return;
+        m_vx = static_cast<int32_t>((static_cast<int64_t>(newest.x - oldest->x) * 1000) / dt);
+        m_vy = static_cast<int32_t>((static_cast<int64_t>(newest.y - oldest->y) * 1000) / dt);
+    }
+
+    void queue(GestureKind kind, GesturePhase phase) noexcept {
+        const GestureInfo info{
+            kind, phase, m_touches, m_point,
+            {m_point.x - m_origin.x, m_point.y - m_origin.y},
+            m_vx, m_vy, m_scale, m_rotation,
+        };
+        if (phase == GesturePhase::update) {
+            // Several reads before a dispatch: keep only the latest update
+            for (uint32_t i = 0; i < m_pending_count; ++i) {
+                if (m_pending[i].kind == kind && m_pending[i].phase == GesturePhase::update) {
+                    m_pending[i] = info;
+                    return;
+                }
+            }
+        }
+        if (m_pending_count < MAX_PENDING) m_pending[m_pending_count++] = info;
+    }
+
+    // ---- Target tracking ----
+
+    static void target_deleted_cb(lv_event_t* e) {
+        static_cast<BasicGestureRecognizer*>(lv_event_get_user_data(e))->m_target = nullptr;
+    }
+
+    static void fixed_target_deleted_cb(lv_event_t* e) {
+        static_cast<BasicGestureRecognizer*>(lv_event_get_user_data(e))->m_fixed_target = nullptr;
+    }
+
+    void set_target(lv_obj_t* obj) noexcept {
+        if (m_target == obj) return;
+        if (m_target) lv_obj_remove_event_cb_with_user_data(m_target, &target_deleted_cb, this);
+        m_target = obj;
+        if (m_target) lv_obj_add_event_cb(m_target, &target_deleted_cb, LV_EVENT_DELETE, this);
+    }
+
+    [[nodiscard]] lv_obj_t* hit_test(lv_point_t p) const noexcept {
+        if (m_fixed_target) return m_fixed_target;
+        lv_display_t* disp = m_indev ? lv_indev_get_display(m_indev) : lv_display_get_default();
+        if (!disp) return nullptr;
+        lv_obj_t* obj = lv_indev_search_obj(lv_display_get_layer_top(disp), &p);
+        if (!obj) obj = lv_indev_search_obj(lv_display_get_screen_active(disp), &p);
+        return obj;
+    }
+
+    // ---- State machine ----
+
+    void release(uint32_t now) noexcept {
+        update_velocity(now);
+        if (m_pinching) queue(GestureKind::pinch, GesturePhase::end);
+        if (m_rotating) queue(GestureKind::rotate, GesturePhase::end);
+        if (m_panning) queue(GestureKind::pan, GesturePhase::end);
+        const int64_t v2 = static_cast<int64_t>(m_vx) * m_vx + static_cast<int64_t>(m_vy) * m_vy;
+        const int64_t min_v = m_cfg.fling_min_velocity;
+        if (v2 >= min_v * min_v) queue(GestureKind::fling, GesturePhase::end);
+        m_down = m_panning = m_pinching = m_rotating = false;
+        m_touches = 0;
+        m_count = 0;
+    }
+
+    void start_two_finger(const TouchPoint& a, const TouchPoint& b) noexcept {
+        m_ids[0] = a.id;
+        m_ids[1] = b.id;
+        const float dx = static_cast<float>(b.point.x - a.point.x);
+        const float dy = static_cast<float>(b.point.y - a.point.y);
+        m_dist0 = std::sqrt(dx * dx + dy * dy);
+        m_angle0 = std::atan2(dy, dx);
+        m_scale = LV_SCALE_NONE;
+        m_rotation = 0;
+    }
+
+    void track_two_finger(const TouchPoint* pts, uint32_t n) noexcept {
+        // Find the baseline contacts by id so a reordered report doesn't flip the angle
+        const TouchPoint* a = nullptr;
+        const TouchPoint* b = nullptr;
+        for (uint32_t i = 0; i < n; ++i) {
+            if (pts[i].id == m_ids[0]) a = &pts[i];
+            else if (pts[i].id == m_ids[1]) b = &pts[i];
+        }
+        if (!a || !b) {
+            end_two_finger();
+            start_two_finger(pts[0], pts[1]);
+            return;
+        }
+        const float dx = static_cast<float>(b->point.x - a->point.x);
+        const float dy = static_cast<float>(b->point.y - a->point.y);
+        if (m_dist0 > 0) {
+            m_scale = static_cast<int32_t>(std::sqrt(dx * dx + dy * dy) / m_dist0 * LV_SCALE_NONE);
+        }
+        float da = std::atan2(dy, dx) - m_angle0;
+        constexpr float PI = 3.14159265f;
+        if (da > PI) da -= 2 * PI;
+        else if (da < -PI) da += 2 * PI;
+        m_rotation = static_cast<int32_t>(da * (1800.0f / PI));
+
+        const int32_t ds = m_scale - LV_SCALE_NONE;
+        if (m_pinching) queue(GestureKind::pinch, GesturePhase::update);
+        else if (ds > m_cfg.pinch_slop || -ds > m_cfg.pinch_slop) {
+            m_pinching = true;
+            queue(GestureKind::pinch, GesturePhase::begin);
+        }
+        if (m_rotating) queue(GestureKind::rotate, GesturePhase::update);
+        else if (m_rotation > m_cfg.rotate_slop || -m_rotation > m_cfg.rotate_slop) {
+            m_rotating = true;
+            queue(GestureKind::rotate, GesturePhase::begin);
+        }
+    }
+
+    void end_two_finger() noexcept {
+        if (m_pinching) queue(GestureKind::pinch, GesturePhase::end);
+        if (m_rotating) queue(GestureKind::rotate, GesturePhase::end);
+        m_pinching = m_rotating = false;
+        m_scale = LV_SCALE_NONE;
+        m_rotation = 0;
+    }
+
+    void update(const TouchPoint* pts, uint32_t n, uint32_t now) noexcept {
+        if (n == 0) {
+            if (m_down) release(now);
+            return;
+        }
+
+        int64_t sx = 0;
+        int64_t sy = 0;
+        for (uint32_t i = 0; i < n; ++i) {
+            sx += pts[i].point.x;
+            sy += pts[i].point.y;
+        }
+        const lv_point_t c{static_cast<int32_t>(sx / n), static_cast<int32_t>(sy / n)};
+
+        if (!m_down) {
+            m_down = true;
+            m_touches = static_cast<uint8_t>(n);
+            m_origin = m_point = c;
+            m_vx = m_vy = 0;
+            m_count = 0;
+            add_sample(now, c);
+            set_target(hit_test(c));
+            if (n >= 2) start_two_finger(pts[0], pts[1]);
+            return;
+        }
+
+        if (n != m_touches) {
+            // Contacts changed: keep the accumulated delta, restart velocity
+            m_origin.x += c.x - m_point.x;
+            m_origin.y += c.y - m_point.y;
+            m_count = 0;
+            if (n >= 2 && m_touches < 2) start_two_finger(pts[0], pts[1]);
+            if (n < 2 && m_touches >= 2) end_two_finger();
+            m_touches = static_cast<uint8_t>(n);
+        }
+
+        const bool moved = c.x != m_point.x || c.y != m_point.y;
+        m_point = c;
+        add_sample(now, c);
+        update_velocity(now);
+
+        if (m_panning) {
+            if (moved) queue(GestureKind::pan, GesturePhase::update);
+        } else {
+            const int32_t dx = c.x - m_origin.x;
+            const int32_t dy = c.y - m_origin.y;
+            if (LV_ABS(dx) > m_cfg.pan_slop || LV_ABS(dy) > m_cfg.pan_slop) {
+                m_panning = true;
+                queue(GestureKind::pan, GesturePhase::begin);
+            }
+        }
+
+        if (n >= 2 && moved) track_two_finger(pts, n);
+    }
+
+    // ---- Indev hooks ----
+
+    static void tap(lv_indev_t*, lv_indev_data_t* data, void* ctx) {
+        auto* self = static_cast<BasicGestureRecognizer*>(ctx);
+        if (self->m_external) return;
+        const TouchPoint pt{0, data->point};
+        self->update(&pt, data->state == LV_INDEV_STATE_PRESSED ? 1 : 0, lv_tick_get());
+    }
+
+    static void indev_read_cb(lv_event_t* e) {
+        static_cast<BasicGestureRecognizer*>(lv_event_get_user_data(e))->dispatch();
+    }
+
+public:
+    /**
+     * @brief Recognize gestures on a pointer indev
+     *
+     * @param indev Pointer indev (nullptr = feed() only, events sent immediately)
+     * @param cfg Thresholds
+     */
+    explicit BasicGestureRecognizer(lv_indev_t* indev = nullptr, GestureConfig cfg = {}) noexcept
+        : m_cfg(cfg) {
+        attach(indev);
+    }
+
+    ~BasicGestureRecognizer() {
+        detach();
+        target(nullptr);
+        set_target(nullptr);
+    }
+
+    BasicGestureRecognizer(const BasicGestureRecognizer&) = delete;
+    BasicGestureRecognizer& operator=(const BasicGestureRecognizer&) = delete;
+
+    /// Attach to a pointer indev (detaches from the previous one)
+    bool attach(lv_indev_t* indev) noexcept {
+        detach();
+        if (!indev || !indev_add_tap(indev, &tap, this)) return false;
+        m_indev = indev;
+        lv_indev_add_event_cb(indev, &indev_read_cb, LV_EVENT_INDEV_READ, this);
+        return true;
+    }
+
+    /// Stop recognizing on the indev
+    void detach() noexcept {
+        if (m_indev) {
+            indev_remove_tap(m_indev, &tap, this);
+            lv_indev_remove_event_cb_with_user_data(m_indev, &indev_read_cb, this);
+            m_indev = nullptr;
+        }
+        m_down = m_panning = m_pinching = m_rotating = false;
+        m_pending_count = 0;
+    }
+
+    /**
+     * @brief Send all events to obj instead of the object under the touch
+     *
+     * @param obj Fixed receiver (nullptr = hit-test on press)
+     */
+    BasicGestureRecognizer& target(lv_obj_t* obj) noexcept {
+        if (m_fixed_target == obj) return *this;
+        if (m_fixed_target) {
+            lv_obj_remove_event_cb_with_user_data(m_fixed_target, &fixed_target_deleted_cb, this);
+        }
+        m_fixed_target = obj;
+        if (obj) lv_obj_add_event_cb(obj, &fixed_target_deleted_cb, LV_EVENT_DELETE, this);
+        return *this;
+    }
+
+    /// Replace the thresholds
+    BasicGestureRecognizer& config(const GestureConfig& cfg) noexcept {
+        m_cfg = cfg;
+        return *this;
+    }
+
+    /// Get the thresholds
+    [[nodiscard]] const GestureConfig& config() const noexcept { return m_cfg; }
+
+    /**
+     * @brief Report all current contacts (multi-touch drivers)
+     *
+     * Call from the driver's read_cb with every contact that is down (n = 0
+     * on release). Once feed() is used, the single-point tap is ignored.
+     *
+     * @param pts Contacts
+     * @param n Number of contacts
+     * @param time_ms Sample time (default: lv_tick_get())
+     */
+    void feed(const TouchPoint* pts, uint32_t n, uint32_t time_ms = lv_tick_get()) noexcept {
+        m_external = true;
+        update(pts, n, time_ms);
+        if (!m_indev) dispatch();
+    }
+
+    /// Send queued events to the target (called automatically after each indev read)
+    void dispatch() noexcept {
+        const uint32_t n = m_pending_count;
+        m_pending_count = 0;
+        for (uint32_t i = 0; i < n; ++i) {
+            if (!m_target) break;
+            GestureInfo info = m_pending[i];
+            lv_obj_send_event(m_target, gesture_event(info.kind), &info);
+        }
+        if (!m_down) set_target(nullptr);
+    }
+
+    /// A touch is down
+    [[nodiscard]] bool active() const noexcept { return m_down; }
+
+    /// Current velocity (px/s)
+    [[nodiscard]] lv_point_t velocity() const noexcept { return {m_vx, m_vy}; }
+
+    /// Receiver of the current gesture
+    [[nodiscard]] lv_obj_t* current_target() const noexcept { return m_target; }
+};
+
+/// Gesture recognizer with a 16-sample history
+using GestureRecognizer = BasicGestureRecognizer<16>;
+
+} // namespace lv
@@ -29,6 +29,13 @@ namespace indev_state {
     constexpr auto pressed = LV_INDEV_STATE_PRESSED;
 } // namespace indev_state
 
+// ==================== Input Device Read Modes ====================
+
+namespace indev_mode {
+    constexpr auto timer = LV_INDEV_MODE_TIMER;   ///< Polled by the indev read timer
+    constexpr auto event = LV_INDEV_MODE_EVENT;   ///< Read only when lv_indev_read() is called
+} // namespace indev_mode
+
 // ==================== Keys ====================
 
 namespace key {
@@ -146,6 +153,35 @@ public:
         return *this;
     }
 
+    // ==================== Read Mode ====================
+
+    /// Set read mode (timer-polled or event-driven)
+    Indev& mode(lv_indev_mode_t m) noexcept {
+        lv_indev_set_mode(m_indev, m);
+        return *this;
+    }
+
+    /// Get read mode
+    [[nodiscard]] lv_indev_mode_t mode() const noexcept {
+        return lv_indev_get_mode(m_indev);
+    }
+
+    /// Switch to event mode: no read timer, call read() when data arrives
+    Indev& event_driven() noexcept {
+        return mode(LV_INDEV_MODE_EVENT);
+    }
+
+    /// Read the device now (runs read_cb and dispatches resulting events)
+    Indev& read() noexcept {
+        lv_indev_read(m_indev);
+        return *this;
+    }
+
+    /// Get the read timer (nullptr in event mode)
+    [[nodiscard]] lv_timer_t* read_timer() const noexcept {
+        return lv_indev_get_read_timer(m_indev);
+    }
+
     // ==================== Group ====================
 
     /// Set group (for keypad/encoder navigation)
@@ -232,7 +268,12 @@ public:
         return *this;
     }
 
-    /// Set scroll throw slowdown (higher = slower deceleration)
+    /**
+     * @brief Set scroll throw slowdown (higher = faster deceleration)
+     *
+     * Applied per indev read, so momentum depends on the read period. Use
+     * lv::scroll_physics() for time-based momentum.
+     */
     Indev& scroll_throw(uint32_t slowdown) noexcept {
         lv_indev_set_scroll_throw(m_indev, slowdown);
         return *this;
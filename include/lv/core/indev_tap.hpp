@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * @file indev_tap.hpp
+ * @brief Observe or adjust input device reads without replacing the driver
+ *
+ * A tap is a function that runs right after an indev's own read_cb, with
+ * access to the lv_indev_data_t it produced. Taps are used by the input
+ * recorder, the touch resampler and latency instrumentation, and can be
+ * stacked on the same indev.
+ *
+ * Taps live in a fixed-size static table (LV_CPP_INDEV_TAP_MAX entries,
+ * default 8), so attaching one never allocates. The original read_cb is
+ * restored when the last tap of an indev is removed; deleting the indev
+ * releases its taps.
+ *
+ * @code
+ * static void log_read(lv_indev_t*, lv_indev_data_t* data, void*) {
+ *     LV_LOG_USER("%d,%d", data->point.x, data->point.y);
+ * }
+ * lv::indev_add_tap(mouse, &log_read);
+ * @endcode
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+
+#ifndef LV_CPP_INDEV_TAP_MAX
+#define LV_CPP_INDEV_TAP_MAX 8
+#endif
+
+namespace lv {
+
+/// Tap callback: runs after the driver's read_cb, may modify data
+using IndevTapFn = void (*)(lv_indev_t* indev, lv_indev_data_t* data, void* ctx);
+
+namespace detail {
+
+struct IndevTapSlot {
+    lv_indev_t* indev;
+    lv_indev_read_cb_t original;  ///< Driver read_cb (same for all slots of an indev)
+    IndevTapFn fn;
+    void* ctx;
+    uint32_t seq;                 ///< Registration order
+};
+
+inline IndevTapSlot g_indev_taps[LV_CPP_INDEV_TAP_MAX] = {};
+inline uint32_t g_indev_tap_seq = 0;
+
+inline void indev_tap_delete_cb(lv_event_t* e) {
+    auto* indev = static_cast<lv_indev_t*>(lv_event_get_target(e));
+    for (auto& slot : g_indev_taps) {
+        if (slot.indev == indev) slot = {};
+    }
+}
+
+inline void indev_tap_read_cb(lv_indev_t* indev, lv_indev_data_t* data) {
+    lv_indev_read_cb_t original = nullptr;
+    for (const auto& slot : g_indev_taps) {
+        if (slot.indev == indev) {
+            original = slot.original;
+            break;
+        }
+    }
+    if (original) {
+        original(indev, data);
+    }
+    // Taps run in registration order (slots are reused, so not slot order);
+    // a tap may remove itself or others
+    uint32_t last = 0;
+    for (;;) {
+        const IndevTapSlot* next = nullptr;
+        for (const auto& slot : g_indev_taps) {
+            if (slot.indev == indev && slot.fn && slot.seq > last && (!next || slot.seq < next->seq)) next = &slot;
+        }
+        if (!next) break;
+        const IndevTapSlot slot = *next;
+        last = slot.seq;
+        slot.fn(indev, data, slot.ctx);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Attach a tap to an input device
+ *
+ * @return false if the tap table is full
+ */
+inline bool indev_add_tap(lv_indev_t* indev, IndevTapFn fn, void* ctx = nullptr) noexcept {
+    lv_indev_read_cb_t original = lv_indev_get_read_cb(indev);
+    const bool tapped = original == &detail::indev_tap_read_cb;
+    if (tapped) {
+        // Already tapped: reuse the driver callback saved by the first tap
+        for (const auto& slot : detail::g_indev_taps) {
+            if (slot.indev == indev) {
+                original = slot.original;
+                break;
+            }
+        }
+    }
+    for (auto& slot : detail::g_indev_taps) {
+        if (!slot.indev) {
+            slot = {indev, original, fn, ctx, ++detail::g_indev_tap_seq};
+            if (!tapped) {
+                lv_indev_set_read_cb(indev, &detail::indev_tap_read_cb);
+                lv_indev_add_event_cb(indev, &detail::indev_tap_delete_cb, LV_EVENT_DELETE, nullptr);
+            }
+            return true;
+        }
+    }
+    LV_LOG_WARN("indev tap table full (LV_CPP_INDEV_TAP_MAX=%d)", LV_CPP_INDEV_TAP_MAX);
+    return false;
+}
+
+/**
+ * @brief Detach a tap (matched by function and context)
+ *
+ * Restores the driver's read_cb when no taps remain on the indev.
+ */
+inline void indev_remove_tap(lv_indev_t* indev, IndevTapFn fn, void* ctx = nullptr) noexcept {
+    lv_indev_read_cb_t original = nullptr;
+    bool remaining = false;
+    for (auto& slot : detail::g_indev_taps) {
+        if (slot.indev != indev) continue;
+        if (slot.fn == fn && slot.ctx == ctx) {
+            original = slot.original;
+            slot = {};
+        } else {
+            remaining = true;
+        }
+    }
+    if (original && !remaining) {
+        lv_indev_set_read_cb(indev, original);
+        lv_indev_remove_event_cb_with_user_data(indev, &detail::indev_tap_delete_cb, nullptr);
+    }
+}
+
+} // namespace lv
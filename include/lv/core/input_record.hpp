@@ -0,0 +1,308 @@
+#pragma once
+
+/**
+ * @file input_record.hpp
+ * @brief Record and replay input device reads for deterministic benchmarks
+ *
+ * InputRecorder taps an existing indev and writes every change of its
+ * reported state (point, key, encoder diff, pressed/released) with a
+ * millisecond timestamp into a compact binary log. InputPlayer is an indev
+ * that replays such a log. Combined with VirtualClock, the replay is
+ * frame-exact and independent of wall-clock time, so the same captured
+ * session can be benchmarked across builds.
+ *
+ * Record on the device:
+ * @code
+ * lv::InputRecorder rec(touch.get(), "/tmp/swipe.lvir");
+ * // ... use the UI, then destroy rec or call rec.stop()
+ * @endcode
+ *
+ * Replay headless:
+ * @code
+ * lv::VirtualClock clock;                 // LVGL time now advances only via clock
+ * lv::InputPlayer player("/tmp/swipe.lvir");
+ * while (!player.finished()) {
+ *     clock.advance(16);
+ *     lv_timer_handler();                 // Measure this call per frame
+ * }
+ * @endcode
+ *
+ * ## Log format (little-endian)
+ *
+ * | Field | Size | Notes |
+ * |-------|------|-------|
+ * | Header | 16 B | `InputLogHeader`: magic "LVIR", version, indev type |
+ * | Records | 16 B each | `InputLogRecord`: time since start, x, y, key, enc_diff, state |
+ *
+ * Identical consecutive reads are not stored.
+ */
+
+#include <lvgl.h>
+#include "indev_tap.hpp"
+#include <cstdint>
+#include <cstdio>
+
+namespace lv {
+
+/// Log file header
+struct InputLogHeader {
+    static constexpr uint32_t MAGIC = 0x5249564C;  // "LVIR" in ASCII (little-endian)
+    static constexpr uint16_t VERSION = 1;
+
+    uint32_t magic = MAGIC;
+    uint16_t version = VERSION;
+    uint8_t indev_type = 0;      ///< lv_indev_type_t of the recorded device
+    uint8_t reserved0 = 0;
+    uint32_t reserved1 = 0;
+    uint32_t reserved2 = 0;
+};
+static_assert(sizeof(InputLogHeader) == 16, "InputLogHeader must be 16 bytes");
+
+/// One recorded indev state
+struct InputLogRecord {
+    uint32_t time_ms;   ///< Milliseconds since recording started
+    int16_t x;
+    int16_t y;
+    uint32_t key;
+    int16_t enc_diff;
+    uint8_t state;      ///< lv_indev_state_t
+    uint8_t flags;      ///< Reserved
+};
+static_assert(sizeof(InputLogRecord) == 16, "InputLogRecord must be 16 bytes");
+
+// ==================== Virtual Clock ====================
+
+/**
+ * @brief Deterministic LVGL tick source
+ *
+ * Installs itself with lv_tick_set_cb(). While alive, lv_tick_get() returns
+ * only what advance() has accumulated, so timers, animations and indev reads
+ * run at exactly the same virtual times on every run.
+ *
+ * Only one VirtualClock may exist at a time. The destructor clears the tick
+ * callback (LVGL falls back to lv_tick_inc()).
+ */
+class VirtualClock {
+    static inline uint32_t s_now = 0;
+
+    static uint32_t tick_cb() { return s_now; }
+
+public:
+    explicit VirtualClock(uint32_t start_ms = 0) noexcept {
+        s_now = start_ms;
+        lv_tick_set_cb(&tick_cb);
+    }
+
+    ~VirtualClock() {
+        lv_tick_set_cb(nullptr);
+    }
+
+    VirtualClock(const VirtualClock&) = delete;
+    VirtualClock& operator=(const VirtualClock&) = delete;
+
+    /// Advance virtual time
+    void advance(uint32_t ms) noexcept { s_now += ms; }
+
+    /// Current virtual time
+    [[nodiscard]] uint32_t now() const noexcept { return s_now; }
+};
+
+// ==================== Recorder ====================
+
+/**
+ * @brief Records all reads of an input device into a binary log
+ *
+ * Non-movable (registered as an indev tap with `this` as context).
+ */
+class InputRecorder {
+    lv_indev_t* m_indev = nullptr;
+    std::FILE* m_file = nullptr;
+    uint32_t m_start = 0;
+    uint32_t m_count = 0;
+    InputLogRecord m_last{};
+    bool m_has_last = false;
+
+    static void tap(lv_indev_t*, lv_indev_data_t* data, void* ctx) {
+        static_cast<InputRecorder*>(ctx)->record(*data);
+    }
+
+    void record(const lv_indev_data_t& data) noexcept {
+        InputLogRecord rec{};
+        rec.time_ms = lv_tick_elaps(m_start);
+        rec.x = static_cast<int16_t>(data.point.x);
+        rec.y = static_cast<int16_t>(data.point.y);
+        rec.key = data.key;
+        rec.enc_diff = data.enc_diff;
+        rec.state = static_cast<uint8_t>(data.state);
+
+        // Skip reads that report nothing new
+        if (m_has_last && rec.enc_diff == 0 && rec.x == m_last.x && rec.y == m_last.y &&
+            rec.key == m_last.key && rec.state == m_last.state) {
+            return;
+        }
+        m_last = rec;
+        m_has_last = true;
+        if (std::fwrite(&rec, sizeof(rec), 1, m_file) == 1) {
+            ++m_count;
+        }
+    }
+
+public:
+    /// Start recording indev to the file at path
+    InputRecorder(lv_indev_t* indev, const char* path) noexcept {
+        start(indev, path);
+    }
+
+    ~InputRecorder() { stop(); }
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    /// (Re)start recording; returns false if the file can't be opened
+    bool start(lv_indev_t* indev, const char* path) noexcept {
+        stop();
+        m_file = std::fopen(path, "wb");
+        if (!m_file) {
+            LV_LOG_WARN("InputRecorder: can't open %s", path);
+            return false;
+        }
+        InputLogHeader header;
+        header.indev_type = static_cast<uint8_t>(lv_indev_get_type(indev));
+        std::fwrite(&header, sizeof(header), 1, m_file);
+
+        m_indev = indev;
+        m_start = lv_tick_get();
+        m_count = 0;
+        m_has_last = false;
+        if (!indev_add_tap(indev, &tap, this)) {
+            std::fclose(m_file);
+            m_file = nullptr;
+            m_indev = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    /// Stop recording and close the log
+    void stop() noexcept {
+        if (m_indev) {
+            indev_remove_tap(m_indev, &tap, this);
+            m_indev = nullptr;
+        }
+        if (m_file) {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+    }
+
+    /// Check if recording
+    [[nodiscard]] bool recording() const noexcept { return m_file != nullptr; }
+
+    /// Number of records written
+    [[nodiscard]] uint32_t count() const noexcept { return m_count; }
+};
+
+// ==================== Player ====================
+
+/**
+ * @brief Input device that replays an InputRecorder log
+ *
+ * Creates its own indev of the recorded type. Records whose timestamp is
+ * <= the time elapsed since the first read are replayed one per read, with
+ * continue_reading set while more are due, so LVGL sees every state (a
+ * press and release in the same period stay a click). The replay follows
+ * lv_tick_get() (real time, or VirtualClock when benchmarking headless).
+ *
+ * Owns its lv_indev_t. Non-movable (driver_data points to this).
+ */
+class InputPlayer {
+    lv_indev_t* m_indev = nullptr;
+    std::FILE* m_file = nullptr;
+    InputLogRecord m_next{};
+    bool m_has_next = false;
+    bool m_started = false;
+    uint32_t m_start = 0;
+    uint32_t m_played = 0;
+    lv_indev_data_t m_current{};
+
+    bool read_next() noexcept {
+        m_has_next = m_file && std::fread(&m_next, sizeof(m_next), 1, m_file) == 1;
+        return m_has_next;
+    }
+
+    static void read_cb(lv_indev_t* indev, lv_indev_data_t* data) {
+        static_cast<InputPlayer*>(lv_indev_get_driver_data(indev))->play(data);
+    }
+
+    void play(lv_indev_data_t* data) noexcept {
+        if (!m_started) {
+            m_started = true;
+            m_start = lv_tick_get();
+        }
+        const uint32_t now = lv_tick_elaps(m_start);
+        if (m_has_next && m_next.time_ms <= now) {
+            m_current.point.x = m_next.x;
+            m_current.point.y = m_next.y;
+            m_current.key = m_next.key;
+            m_current.enc_diff = m_next.enc_diff;
+            m_current.state = static_cast<lv_indev_state_t>(m_next.state);
+            ++m_played;
+            read_next();
+        }
+        data->point = m_current.point;
+        data->key = m_current.key;
+        data->enc_diff = m_current.enc_diff;
+        data->state = m_current.state;
+        data->continue_reading = m_has_next && m_next.time_ms <= now;
+        m_current.enc_diff = 0;
+    }
+
+public:
+    /// Open a log and create the replay indev
+    explicit InputPlayer(const char* path) noexcept {
+        m_file = std::fopen(path, "rb");
+        InputLogHeader header;
+        if (!m_file || std::fread(&header, sizeof(header), 1, m_file) != 1 ||
+            header.magic != InputLogHeader::MAGIC || header.version != InputLogHeader::VERSION) {
+            LV_LOG_WARN("InputPlayer: %s is not a valid input log", path);
+            if (m_file) std::fclose(m_file);
+            m_file = nullptr;
+            header = InputLogHeader{};
+            header.indev_type = LV_INDEV_TYPE_POINTER;
+        }
+        m_current.state = LV_INDEV_STATE_RELEASED;
+
+        m_indev = lv_indev_create();
+        lv_indev_set_type(m_indev, static_cast<lv_indev_type_t>(header.indev_type));
+        lv_indev_set_read_cb(m_indev, &read_cb);
+        lv_indev_set_driver_data(m_indev, this);
+        read_next();
+    }
+
+    ~InputPlayer() {
+        if (m_indev) lv_indev_delete(m_indev);
+        if (m_file) std::fclose(m_file);
+    }
+
+    InputPlayer(const InputPlayer&) = delete;
+    InputPlayer& operator=(const InputPlayer&) = delete;
+
+    /// Get underlying input device pointer
+    [[nodiscard]] lv_indev_t* get() const noexcept { return m_indev; }
+
+    /// Check if the log was opened successfully
+    [[nodiscard]] bool valid() const noexcept { return m_file != nullptr; }
+
+    /// All records have been replayed
+    [[nodiscard]] bool finished() const noexcept { return !m_has_next; }
+
+    /// Number of records replayed so far
+    [[nodiscard]] uint32_t played() const noexcept { return m_played; }
+
+    /// Timestamp of the next record (ms since start), or 0 when finished
+    [[nodiscard]] uint32_t next_time() const noexcept {
+        return m_has_next ? m_next.time_ms : 0;
+    }
+};
+
+} // namespace lv
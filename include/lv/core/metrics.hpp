@@ -0,0 +1,320 @@
+#pragma once
+
+/**
+ * @file metrics.hpp
+ * @brief Input-to-screen latency instrumentation
+ *
+ * lv::metrics::InputLatency follows one input through the pipeline:
+ *
+ * | Stage | Marked by |
+ * |-------|-----------|
+ * | input | Indev read that reports a new state (indev tap) |
+ * | dispatch | `LV_EVENT_INDEV_READ` on the indev: all object events for the read have run |
+ * | render | `LV_EVENT_RENDER_READY` on the display, after the input invalidated something |
+ * | flush | The frame's last transfer completed (`lv_display_flush_ready()`) |
+ *
+ * Each stage feeds a log2 histogram of the time since the input (µs), so
+ * `flush()` is the end-to-end input→screen latency. It includes
+ * asynchronous (DMA, AsyncFlush) transfers: if the last one is still in
+ * flight at `LV_EVENT_REFR_READY`, its completion is taken from
+ * `LV_EVENT_FLUSH_WAIT_FINISH` or from polling the display every millisecond.
+ *
+ * @code
+ * lv::metrics::InputLatency latency(touch.get());   // Display: the indev's display
+ * // ... interact ...
+ * latency.log();
+ * uint32_t p95 = latency.flush().percentile(95);
+ * @endcode
+ *
+ * Inputs that invalidate nothing are counted in `dispatch()` only. While an
+ * input waits to be rendered, further inputs are coalesced into it: latency
+ * is measured from the first input the frame shows.
+ */
+
+#include <lvgl.h>
+#include <src/display/lv_display_private.h>   // flushing
+#include "indev_tap.hpp"
+#include <chrono>
+#include <cstdint>
+
+namespace lv::metrics {
+
+/**
+ * @brief Log2 latency histogram in microseconds
+ *
+ * Bucket i holds samples in [2^i, 2^(i+1)) µs (bucket 0 also holds 0);
+ * the last bucket holds everything above.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t BUCKETS = 20;   ///< Up to ~0.5 s resolved
+
+private:
+    uint32_t m_buckets[BUCKETS] = {};
+    uint32_t m_count = 0;
+    uint64_t m_sum = 0;
+    uint32_t m_min = UINT32_MAX;
+    uint32_t m_max = 0;
+
+    [[nodiscard]] static uint32_t bucket_of(uint32_t us) noexcept {
+        uint32_t b = 0;
+        while (us > 1 && b < BUCKETS - 1) {
+            us >>= 1;
+            ++b;
+        }
+        return b;
+    }
+
+public:
+    /// Add a sample
+    void add(uint32_t us) noexcept {
+        ++m_buckets[bucket_of(us)];
+        ++m_count;
+        m_sum += us;
+        if (us < m_min) m_min = us;
+        if (us > m_max) m_max = us;
+    }
+
+    /// Clear all samples
+    void reset() noexcept { *this = LatencyHistogram{}; }
+
+    [[nodiscard]] uint32_t count() const noexcept { return m_count; }
+    [[nodiscard]] uint32_t min() const noexcept { return m_count ? m_min : 0; }
+    [[nodiscard]] uint32_t max() const noexcept { return m_max; }
+
+    [[nodiscard]] uint32_t mean() const noexcept {
+        return m_count ? static_cast<uint32_t>(m_sum / m_count) : 0;
+    }
+
+    /// Samples in bucket i
+    [[nodiscard]] uint32_t bucket(uint32_t i) const noexcept {
+        return i < BUCKETS ? m_buckets[i] : 0;
+    }
+
+    /**
+     * @brief Approximate percentile (upper bound of the bucket it falls in)
+     *
+     * @param p Percentile 0..100
+     */
+    [[nodiscard]] uint32_t percentile(uint32_t p) const noexcept {
+        if (!m_count) return 0;
+        const uint64_t rank = (static_cast<uint64_t>(m_count) * LV_MIN(p, 100u) + 99) / 100;
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BUCKETS; ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank && seen) {
+                const uint32_t upper = i == BUCKETS - 1 ? m_max : (2u << i) - 1;
+                return LV_MIN(upper, m_max);
+            }
+        }
+        return m_max;
+    }
+};
+
+/**
+ * @brief Measures input→dispatch→render→flush latency of one indev/display pair
+ *
+ * Non-movable (registered as tap and event callback with `this` as user data).
+ */
+class InputLatency {
+    using Clock = std::chrono::steady_clock;
+
+    enum class Stage : uint8_t {
+        idle,        ///< Nothing in flight
+        input,       ///< New input read, events not dispatched yet
+        dispatched,  ///< Events dispatched, waiting for the frame that shows them
+        rendered,    ///< Rendered, waiting for the refresh to finish flushing
+        flushing,    ///< Refresh finished, last transfer still in flight
+    };
+
+    lv_indev_t* m_indev = nullptr;
+    lv_display_t* m_display = nullptr;
+    lv_timer_t* m_poll = nullptr;   ///< Watches an in-flight transfer after the refresh
+
+    Stage m_stage = Stage::idle;
+    bool m_invalidated = false;   ///< Current input caused an invalidation
+    Clock::time_point m_input{};
+
+    lv_indev_data_t m_last{};
+    bool m_has_last = false;
+
+    LatencyHistogram m_dispatch;
+    LatencyHistogram m_render;
+    LatencyHistogram m_flush_hist;
+
+    [[nodiscard]] uint32_t since_input(Clock::time_point t) const noexcept {
+        return static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(t - m_input).count());
+    }
+
+    [[nodiscard]] bool changed(const lv_indev_data_t& data) const noexcept {
+        return !m_has_last || data.enc_diff != 0 || data.state != m_last.state ||
+               data.point.x != m_last.point.x || data.point.y != m_last.point.y ||
+               data.key != m_last.key;
+    }
+
+    static void tap(lv_indev_t*, lv_indev_data_t* data, void* ctx) {
+        static_cast<InputLatency*>(ctx)->on_read(*data);
+    }
+
+    void on_read(const lv_indev_data_t& data) noexcept {
+        if (!changed(data)) return;
+        m_last = data;
+        m_has_last = true;
+        // Coalesce into an input that is still in flight
+        if (m_stage == Stage::input || m_stage == Stage::rendered || m_stage == Stage::flushing) return;
+        if (m_stage == Stage::dispatched && m_invalidated) return;
+        m_stage = Stage::input;
+        m_invalidated = false;
+        m_input = Clock::now();
+    }
+
+    static void indev_event_cb(lv_event_t* e) {
+        static_cast<InputLatency*>(lv_event_get_user_data(e))->on_dispatched();
+    }
+
+    void on_dispatched() noexcept {
+        if (m_stage != Stage::input) return;
+        m_dispatch.add(since_input(Clock::now()));
+        // Without an invalidation yet, the next new input replaces this one
+        m_stage = Stage::dispatched;
+    }
+
+    static void display_event_cb(lv_event_t* e) {
+        static_cast<InputLatency*>(lv_event_get_user_data(e))->on_display(lv_event_get_code(e));
+    }
+
+    void on_display(lv_event_code_t code) noexcept {
+        switch (code) {
+        case LV_EVENT_INVALIDATE_AREA:
+            if (m_stage == Stage::input || m_stage == Stage::dispatched) m_invalidated = true;
+            break;
+        case LV_EVENT_RENDER_READY:
+            if (m_stage == Stage::dispatched && m_invalidated) {
+                m_render.add(since_input(Clock::now()));
+                m_stage = Stage::rendered;
+            }
+            break;
+        case LV_EVENT_FLUSH_WAIT_FINISH:
+            // LVGL waited for the previous transfer before sending the next area
+            if (m_stage == Stage::flushing) flushed();
+            break;
+        case LV_EVENT_REFR_READY:
+            if (m_stage != Stage::rendered) break;
+            if (m_display->flushing) {
+                m_stage = Stage::flushing;
+                lv_timer_resume(m_poll);
+            } else {
+                flushed();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    static void poll_cb(lv_timer_t* t) {
+        auto* self = static_cast<InputLatency*>(lv_timer_get_user_data(t));
+        if (self->m_stage != Stage::flushing) lv_timer_pause(t);
+        else if (!self->m_display->flushing) self->flushed();
+    }
+
+    /// The frame's last transfer is done
+    void flushed() noexcept {
+        m_flush_hist.add(since_input(Clock::now()));
+        m_stage = Stage::idle;
+        m_invalidated = false;
+        lv_timer_pause(m_poll);
+    }
+
+public:
+    /**
+     * @brief Start measuring
+     *
+     * @param indev Input device to follow
+     * @param display Display it renders to (nullptr = the indev's display, or the default)
+     */
+    explicit InputLatency(lv_indev_t* indev, lv_display_t* display = nullptr) noexcept {
+        attach(indev, display);
+    }
+
+    ~InputLatency() { detach(); }
+
+    InputLatency(const InputLatency&) = delete;
+    InputLatency& operator=(const InputLatency&) = delete;
+
+    /// Attach to an indev/display pair (detaches first)
+    bool attach(lv_indev_t* indev, lv_display_t* display = nullptr) noexcept {
+        detach();
+        if (!indev) return false;
+        if (!display) display = lv_indev_get_display(indev);
+        if (!display) display = lv_display_get_default();
+        if (!display || !indev_add_tap(indev, &tap, this)) return false;
+
+        m_indev = indev;
+        m_display = display;
+        m_poll = lv_timer_create(&poll_cb, 1, this);
+        lv_timer_pause(m_poll);
+        lv_indev_add_event_cb(indev, &indev_event_cb, LV_EVENT_INDEV_READ, this);
+        lv_display_add_event_cb(display, &display_event_cb, LV_EVENT_INVALIDATE_AREA, this);
+        lv_display_add_event_cb(display, &display_event_cb, LV_EVENT_RENDER_READY, this);
+        lv_display_add_event_cb(display, &display_event_cb, LV_EVENT_FLUSH_WAIT_FINISH, this);
+        lv_display_add_event_cb(display, &display_event_cb, LV_EVENT_REFR_READY, this);
+        return true;
+    }
+
+    /// Stop measuring (histograms are kept)
+    void detach() noexcept {
+        if (m_indev) {
+            indev_remove_tap(m_indev, &tap, this);
+            lv_indev_remove_event_cb_with_user_data(m_indev, &indev_event_cb, this);
+            m_indev = nullptr;
+        }
+        if (m_display) {
+            lv_display_remove_event_cb_with_user_data(m_display, &display_event_cb, this);
+            m_display = nullptr;
+        }
+        if (m_poll) {
+            lv_timer_delete(m_poll);
+            m_poll = nullptr;
+        }
+        m_stage = Stage::idle;
+        m_invalidated = false;
+        m_has_last = false;
+    }
+
+    /// Clear all histograms
+    void reset() noexcept {
+        m_dispatch.reset();
+        m_render.reset();
+        m_flush_hist.reset();
+    }
+
+    /// Input → all object events dispatched
+    [[nodiscard]] const LatencyHistogram& dispatch() const noexcept { return m_dispatch; }
+
+    /// Input → frame rendered
+    [[nodiscard]] const LatencyHistogram& render() const noexcept { return m_render; }
+
+    /// Input → frame flushed (end-to-end)
+    [[nodiscard]] const LatencyHistogram& flush() const noexcept { return m_flush_hist; }
+
+    /// Print a summary with LV_LOG_USER
+    void log() const noexcept {
+        const struct {
+            const char* name;
+            const LatencyHistogram& h;
+        } rows[] = {{"dispatch", m_dispatch}, {"render", m_render}, {"flush", m_flush_hist}};
+        for ([[maybe_unused]] const auto& row : rows) {
+            LV_LOG_USER("input->%-8s n=%u mean=%uus p50=%uus p95=%uus max=%uus",
+                        row.name,
+                        static_cast<unsigned>(row.h.count()),
+                        static_cast<unsigned>(row.h.mean()),
+                        static_cast<unsigned>(row.h.percentile(50)),
+                        static_cast<unsigned>(row.h.percentile(95)),
+                        static_cast<unsigned>(row.h.max()));
+        }
+    }
+};
+
+} // namespace lv::metrics
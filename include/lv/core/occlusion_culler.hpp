@@ -0,0 +1,258 @@
+#pragma once
+
+/**
+ * @file occlusion_culler.hpp
+ * @brief Skip rendering widgets hidden behind opaque widgets
+ *
+ * LVGL starts each dirty area at the topmost object that covers all of it,
+ * but an object covering only part of the area doesn't stop what is behind
+ * it from being drawn. With stacked full-screen backgrounds and opaque
+ * panels, most of that work never reaches the screen.
+ *
+ * Before each refresh OcclusionCuller walks the display's layers in draw
+ * order and records which objects are opaque, using the widgets' own
+ * `LV_EVENT_COVER_CHECK` (solid `bg_opa`, no radius, images without
+ * alpha, ...). An object whose whole drawn area lies behind one opaque
+ * object drawn later is hidden, with its children, until the frame is
+ * flushed:
+ *
+ * @code
+ * lv::OcclusionCuller culler(display);
+ * // ...
+ * if (!culler.occluded(speed_label)) speed_label.text(buf);   // Skip updates nobody sees
+ * culler.log();   // Objects and pixels culled
+ * @endcode
+ *
+ * Occluders are single objects (no union of several), clipped by their
+ * parents. Objects drawn through a layer (opa_layered, transforms, blend
+ * modes) never occlude. Frames during a screen load animation are not
+ * culled. Only `HIDDEN` is set, directly on the object, so layout, events
+ * and input are untouched.
+ */
+
+#include <lvgl.h>
+#include <src/core/lv_obj_private.h>         // obj->flags, spec_attr->layer_type
+#include <src/core/lv_obj_event_private.h>   // lv_cover_check_info_t
+#include "refresh_policy.hpp"
+#include <cstdint>
+
+namespace lv {
+
+/// Culling statistics
+struct CullStats {
+    uint32_t frames = 0;          ///< Refreshes with dirty areas
+    uint32_t last_objects = 0;    ///< Objects recorded in the last frame
+    uint32_t last_occluders = 0;  ///< Opaque objects in the last frame
+    uint32_t last_culled = 0;     ///< Objects (subtrees) culled in the last frame
+    uint64_t last_pixels = 0;     ///< Dirty pixels not drawn in the last frame
+    uint64_t culled = 0;          ///< Objects culled in total
+    uint64_t pixels = 0;          ///< Dirty pixels not drawn in total
+};
+
+/**
+ * @brief Hides occluded objects of one display while it renders
+ *
+ * Non-movable (registered as display event callback with `this` as user
+ * data). Destroy before the display is deleted.
+ */
+class OcclusionCuller {
+    struct Entry {
+        lv_obj_t* obj;
+        lv_area_t area;    ///< Drawn area (ext draw area, clipped)
+        lv_area_t cover;   ///< Opaque area (x1 > x2 if none)
+        uint32_t end;      ///< One past the last entry of the subtree
+    };
+
+    lv_display_t* m_display = nullptr;
+    Entry* m_entries = nullptr;
+    uint32_t m_capacity = 0;
+    uint32_t m_count = 0;
+    lv_obj_t** m_culled = nullptr;
+    uint32_t m_culled_count = 0;
+    bool m_hidden = false;
+    CullStats m_stats;
+
+    [[nodiscard]] static uint64_t size_of(const lv_area_t& a) noexcept {
+        return static_cast<uint64_t>(lv_area_get_width(&a)) * static_cast<uint64_t>(lv_area_get_height(&a));
+    }
+
+    [[nodiscard]] static bool in_layer(const lv_obj_t* obj) noexcept {
+        return obj->spec_attr && obj->spec_attr->layer_type != LV_LAYER_TYPE_NONE;
+    }
+
+    /// Record obj and its subtree in draw order
+    void collect(lv_obj_t* obj, const lv_area_t& clip, bool can_cover) noexcept {
+        if (m_count == m_capacity || (obj->flags & LV_OBJ_FLAG_HIDDEN)) return;
+
+        lv_area_t ext = obj->coords;
+        lv_area_increase(&ext, lv_obj_get_ext_draw_size(obj), lv_obj_get_ext_draw_size(obj));
+        lv_area_t area;
+        const bool visible = lv_area_intersect(&area, &ext, &clip);
+        const bool overflow = obj->flags & LV_OBJ_FLAG_OVERFLOW_VISIBLE;
+        if (!visible && !overflow) return;
+
+        Entry& e = m_entries[m_count];
+        const uint32_t index = m_count++;
+        e.obj = obj;
+        // Children of an overflowing object can be drawn anywhere: never cull it
+        e.area = visible && !overflow ? area : lv_area_t{0, 0, -1, -1};
+        e.cover = {0, 0, -1, -1};
+
+        can_cover = can_cover && !in_layer(obj) && lv_obj_get_style_opa(obj, LV_PART_MAIN) >= LV_OPA_MAX;
+        if (can_cover && visible) {
+            lv_cover_check_info_t info;
+            info.res = LV_COVER_RES_COVER;
+            info.area = &obj->coords;
+            lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+            if (info.res == LV_COVER_RES_COVER) lv_area_intersect(&e.cover, &obj->coords, &clip);
+        }
+
+        // Children are clipped to the parent unless it lets them overflow
+        lv_area_t child_clip = clip;
+        if (!overflow && !lv_area_intersect(&child_clip, &obj->coords, &clip)) {
+            m_entries[index].end = m_count;
+            return;
+        }
+        const uint32_t n = lv_obj_get_child_count(obj);
+        for (uint32_t i = 0; i < n; ++i) collect(lv_obj_get_child(obj, static_cast<int32_t>(i)), child_clip, can_cover);
+        m_entries[index].end = m_count;
+    }
+
+    [[nodiscard]] uint64_t dirty_overlap(const lv_area_t& a) const noexcept {
+        uint64_t px = 0;
+        for (uint32_t i = 0; i < m_display->inv_p; ++i) {
+            lv_area_t o;
+            if (!m_display->inv_area_joined[i] && lv_area_intersect(&o, &a, &m_display->inv_areas[i])) px += size_of(o);
+        }
+        return px;
+    }
+
+    static void event_cb(lv_event_t* e) {
+        auto* self = static_cast<OcclusionCuller*>(lv_event_get_user_data(e));
+        if (lv_event_get_code(e) == LV_EVENT_REFR_START) self->cull();
+        else self->restore();
+    }
+
+    void cull() noexcept {
+        lv_display_t* disp = m_display;
+        restore();
+        if (disp->inv_p == 0) return;
+        m_culled_count = 0;
+        if (lv_display_get_screen_prev(disp)) return;
+        detail::update_layouts(disp);
+
+        const lv_area_t screen{0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                               lv_display_get_vertical_resolution(disp) - 1};
+        m_count = 0;
+        collect(lv_display_get_layer_bottom(disp), screen, true);
+        collect(lv_display_get_screen_active(disp), screen, true);
+        collect(lv_display_get_layer_top(disp), screen, true);
+        collect(lv_display_get_layer_sys(disp), screen, true);
+
+        uint32_t occluders = 0;
+        for (uint32_t j = 0; j < m_count; ++j) occluders += m_entries[j].cover.x1 <= m_entries[j].cover.x2;
+
+        uint64_t pixels = 0;
+        for (uint32_t i = 0; i < m_count;) {
+            const Entry& e = m_entries[i];
+            bool covered = false;
+            if (e.area.x1 <= e.area.x2) {
+                for (uint32_t j = e.end; j < m_count && !covered; ++j) {
+                    const lv_area_t& c = m_entries[j].cover;
+                    covered = c.x1 <= c.x2 && lv_area_is_in(&e.area, &c, 0);
+                }
+            }
+            if (!covered) {
+                ++i;
+                continue;
+            }
+            // Only worth hiding if it would be drawn this frame
+            if (const uint64_t px = dirty_overlap(e.area)) {
+                e.obj->flags |= LV_OBJ_FLAG_HIDDEN;
+                m_culled[m_culled_count++] = e.obj;
+                pixels += px;
+            }
+            i = e.end;
+        }
+        m_hidden = m_culled_count > 0;
+
+        ++m_stats.frames;
+        m_stats.last_objects = m_count;
+        m_stats.last_occluders = occluders;
+        m_stats.last_culled = m_culled_count;
+        m_stats.last_pixels = pixels;
+        m_stats.culled += m_culled_count;
+        m_stats.pixels += pixels;
+    }
+
+    void restore() noexcept {
+        if (!m_hidden) return;
+        for (uint32_t i = 0; i < m_culled_count; ++i) m_culled[i]->flags &= ~LV_OBJ_FLAG_HIDDEN;
+        m_hidden = false;
+    }
+
+public:
+    /**
+     * @brief Start culling a display's occluded objects
+     *
+     * @param display Display to cull (nullptr = default display)
+     * @param max_objects Objects recorded per frame; objects past this are
+     *        drawn normally
+     */
+    explicit OcclusionCuller(lv_display_t* display = nullptr, uint32_t max_objects = 256) noexcept {
+        if (!display) display = lv_display_get_default();
+        if (!display || max_objects == 0) return;
+        m_entries = static_cast<Entry*>(lv_malloc(sizeof(Entry) * max_objects));
+        m_culled = static_cast<lv_obj_t**>(lv_malloc(sizeof(lv_obj_t*) * max_objects));
+        if (!m_entries || !m_culled) {
+            LV_LOG_WARN("OcclusionCuller: out of memory for %u objects", static_cast<unsigned>(max_objects));
+            return;
+        }
+        m_capacity = max_objects;
+        m_display = display;
+        lv_display_add_event_cb(display, &event_cb, LV_EVENT_REFR_START, this);
+        lv_display_add_event_cb(display, &event_cb, LV_EVENT_REFR_READY, this);
+    }
+
+    ~OcclusionCuller() {
+        if (m_display) {
+            restore();
+            lv_display_remove_event_cb_with_user_data(m_display, &event_cb, this);
+        }
+        lv_free(m_entries);
+        lv_free(m_culled);
+    }
+
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    /// Whether obj (or one of its parents) was culled in the last rendered frame
+    [[nodiscard]] bool occluded(const lv_obj_t* obj) const noexcept {
+        for (; obj; obj = lv_obj_get_parent(obj)) {
+            for (uint32_t i = 0; i < m_culled_count; ++i) {
+                if (m_culled[i] == obj) return true;
+            }
+        }
+        return false;
+    }
+
+    /// Culling statistics
+    [[nodiscard]] const CullStats& stats() const noexcept { return m_stats; }
+
+    /// Reset the statistics
+    OcclusionCuller& reset_stats() noexcept {
+        m_stats = {};
+        return *this;
+    }
+
+    /// Print statistics with LV_LOG_USER
+    void log() const noexcept {
+        LV_LOG_USER("OcclusionCuller: frames=%u last %u objects, %u opaque, %u culled (%upx), total %u culled (%ukpx)",
+                    static_cast<unsigned>(m_stats.frames), static_cast<unsigned>(m_stats.last_objects),
+                    static_cast<unsigned>(m_stats.last_occluders), static_cast<unsigned>(m_stats.last_culled),
+                    static_cast<unsigned>(m_stats.last_pixels), static_cast<unsigned>(m_stats.culled),
+                    static_cast<unsigned>(m_stats.pixels / 1000));
+    }
+};
+
+} // namespace lv
@@ -0,0 +1,346 @@
+#pragma once
+
+/**
+ * @file refresh_policy.hpp
+ * @brief Configurable merging of invalidated areas before each refresh
+ *
+ * LVGL renders every invalidated area as its own pass and only joins two
+ * areas when their bounding box is smaller than both together. Many small
+ * invalidations (clock hands, counters, sparklines) then cost many passes,
+ * while one big join can redraw far more than changed. RefreshPolicy
+ * rewrites a display's dirty list at `LV_EVENT_REFR_START`, in this order:
+ *
+ * 1. tiles(w, h): snap areas to a tile grid and coalesce dirty tiles into rectangles
+ * 2. merge_overhead(pct): join two areas if their bounding box is at most
+ *    pct % larger than both together
+ * 3. max_rects(n): join the cheapest pairs until at most n areas remain
+ *
+ * @code
+ * lv::RefreshPolicy policy(display);
+ * policy.merge_overhead(30).max_rects(6);
+ * // ...
+ * policy.log();   // Areas in/out and overdraw of the last frame
+ * @endcode
+ *
+ * Each step is off until set. LVGL's own join still runs afterwards but
+ * never increases the rendered area. Full render mode is left alone.
+ */
+
+#include <lvgl.h>
+#include <src/display/lv_display_private.h>   // inv_areas, inv_area_joined, inv_p
+#include <bit>
+#include <cstdint>
+
+namespace lv {
+
+/// Dirty-area statistics of one display
+struct RefreshStats {
+    uint32_t frames = 0;          ///< Refreshes with dirty areas
+    uint32_t last_in = 0;         ///< Areas invalidated in the last frame
+    uint32_t last_out = 0;        ///< Areas rendered in the last frame
+    uint32_t last_dirty_px = 0;   ///< Invalidated pixels in the last frame (overlaps counted twice)
+    uint32_t last_render_px = 0;  ///< Rendered pixels in the last frame
+    uint64_t dirty_px = 0;        ///< Invalidated pixels in total
+    uint64_t render_px = 0;       ///< Rendered pixels in total
+    uint64_t areas_in = 0;        ///< Areas invalidated in total
+    uint64_t areas_out = 0;       ///< Areas rendered in total
+
+    /// Rendered / invalidated pixels in percent (100 = no overdraw)
+    [[nodiscard]] uint32_t overdraw() const noexcept {
+        return dirty_px ? static_cast<uint32_t>(render_px * 100 / dirty_px) : 100;
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Run pending layout updates of a display
+ *
+ * Layouts invalidate too; called at `LV_EVENT_REFR_START` so the dirty
+ * list is complete (LVGL's own update right after is then a no-op).
+ */
+inline void update_layouts(lv_display_t* disp) noexcept {
+    lv_obj_update_layout(lv_display_get_screen_active(disp));
+    if (lv_obj_t* prev = lv_display_get_screen_prev(disp)) lv_obj_update_layout(prev);
+    lv_obj_update_layout(lv_display_get_layer_bottom(disp));
+    lv_obj_update_layout(lv_display_get_layer_top(disp));
+    lv_obj_update_layout(lv_display_get_layer_sys(disp));
+}
+
+/**
+ * @brief Fixed-capacity list of dirty areas and the merge steps of RefreshPolicy
+ *
+ * Kept apart from the display so the merging can be tested on its own.
+ */
+template<uint32_t N>
+struct DirtyAreas {
+    lv_area_t areas[N];
+    uint32_t count = 0;
+
+    /// Tile grid resolution limit per axis (one uint64_t bit row per tile row)
+    static constexpr int32_t MAX_TILES = 64;
+
+    [[nodiscard]] static uint64_t size_of(const lv_area_t& a) noexcept {
+        return static_cast<uint64_t>(lv_area_get_width(&a)) * static_cast<uint64_t>(lv_area_get_height(&a));
+    }
+
+    [[nodiscard]] static lv_area_t join(const lv_area_t& a, const lv_area_t& b) noexcept {
+        return {LV_MIN(a.x1, b.x1), LV_MIN(a.y1, b.y1), LV_MAX(a.x2, b.x2), LV_MAX(a.y2, b.y2)};
+    }
+
+    /// Extra pixels rendered if a and b were joined (negative if they overlap)
+    [[nodiscard]] static int64_t join_cost(const lv_area_t& a, const lv_area_t& b) noexcept {
+        const lv_area_t u = join(a, b);
+        return static_cast<int64_t>(size_of(u)) - static_cast<int64_t>(size_of(a) + size_of(b));
+    }
+
+    [[nodiscard]] uint64_t pixels() const noexcept {
+        uint64_t px = 0;
+        for (uint32_t i = 0; i < count; ++i) px += size_of(areas[i]);
+        return px;
+    }
+
+    void remove(uint32_t i) noexcept {
+        areas[i] = areas[--count];
+    }
+
+    /// Add an area; when full, join it into the area where that costs least
+    void push(const lv_area_t& a) noexcept {
+        if (count < N) {
+            areas[count++] = a;
+            return;
+        }
+        uint32_t best = 0;
+        int64_t best_cost = INT64_MAX;
+        for (uint32_t i = 0; i < count; ++i) {
+            const int64_t cost = join_cost(areas[i], a);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best = i;
+            }
+        }
+        areas[best] = join(areas[best], a);
+    }
+
+    /**
+     * @brief Snap to a tile grid and coalesce dirty tiles into rectangles
+     *
+     * Tiles are at least tile_w x tile_h and grow so the grid has at most
+     * MAX_TILES columns and rows. Areas must lie within hor_res x ver_res.
+     */
+    void coalesce_tiles(int32_t tile_w, int32_t tile_h, int32_t hor_res, int32_t ver_res) noexcept {
+        constexpr int32_t n = MAX_TILES;
+        const int32_t tw = LV_MAX(tile_w, (hor_res + n - 1) / n);
+        const int32_t th = LV_MAX(tile_h, (ver_res + n - 1) / n);
+        const int32_t rows = (ver_res + th - 1) / th;
+
+        uint64_t grid[MAX_TILES] = {};
+        for (uint32_t i = 0; i < count; ++i) {
+            const lv_area_t& a = areas[i];
+            const int32_t c1 = a.x2 / tw;
+            const int32_t c0 = a.x1 / tw;
+            const uint64_t bits = (c1 - c0 + 1 == 64 ? ~0ull : ((1ull << (c1 - c0 + 1)) - 1)) << c0;
+            for (int32_t r = a.y1 / th; r <= a.y2 / th; ++r) grid[r] |= bits;
+        }
+
+        // Each run of dirty tiles grows downwards while the rows below have it too
+        count = 0;
+        for (int32_t r = 0; r < rows; ++r) {
+            while (grid[r]) {
+                const int32_t c0 = std::countr_zero(grid[r]);
+                const int32_t len = std::countr_one(grid[r] >> c0);
+                const uint64_t run = (len == 64 ? ~0ull : ((1ull << len) - 1)) << c0;
+                int32_t r1 = r;
+                grid[r] &= ~run;
+                while (r1 + 1 < rows && (grid[r1 + 1] & run) == run) {
+                    grid[++r1] &= ~run;
+                }
+                push({c0 * tw, r * th,
+                      LV_MIN((c0 + len) * tw, hor_res) - 1, LV_MIN((r1 + 1) * th, ver_res) - 1});
+            }
+        }
+    }
+
+    /// Join two areas while their bounding box is at most pct % larger than both together
+    void merge_by_overhead(uint32_t pct) noexcept {
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (uint32_t i = 0; i < count && !merged; ++i) {
+                for (uint32_t j = i + 1; j < count; ++j) {
+                    const lv_area_t u = join(areas[i], areas[j]);
+                    if (size_of(u) * 100 <= (size_of(areas[i]) + size_of(areas[j])) * (100 + pct)) {
+                        areas[i] = u;
+                        remove(j);
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /// Join the cheapest pairs until at most max areas remain
+    void cap_rects(uint32_t max) noexcept {
+        while (count > max && count > 1) {
+            uint32_t bi = 0;
+            uint32_t bj = 1;
+            int64_t best = INT64_MAX;
+            for (uint32_t i = 0; i < count; ++i) {
+                for (uint32_t j = i + 1; j < count; ++j) {
+                    const int64_t cost = join_cost(areas[i], areas[j]);
+                    if (cost < best) {
+                        best = cost;
+                        bi = i;
+                        bj = j;
+                    }
+                }
+            }
+            areas[bi] = join(areas[bi], areas[bj]);
+            remove(bj);
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Rewrites a display's invalidated areas before rendering
+ *
+ * Non-movable (registered as display event callback with `this` as user
+ * data). Destroy before the display is deleted.
+ */
+class RefreshPolicy {
+public:
+    /// Capacity of LVGL's dirty list
+    static constexpr uint32_t MAX_AREAS = LV_INV_BUF_SIZE;
+
+    /// Tile grid resolution limit per axis (tiles grow on larger displays)
+    static constexpr uint32_t MAX_TILES = detail::DirtyAreas<MAX_AREAS>::MAX_TILES;
+
+private:
+    lv_display_t* m_display = nullptr;
+    uint32_t m_overhead = 0;      ///< Percent, 0 = off
+    bool m_merge = false;
+    int32_t m_tile_w = 0;         ///< 0 = off
+    int32_t m_tile_h = 0;
+    uint32_t m_max_rects = 0;     ///< 0 = no cap
+    RefreshStats m_stats;
+
+    detail::DirtyAreas<MAX_AREAS> m_areas;
+
+    static void refr_start_cb(lv_event_t* e) {
+        static_cast<RefreshPolicy*>(lv_event_get_user_data(e))->apply();
+    }
+
+    void apply() noexcept {
+        lv_display_t* disp = m_display;
+        if (disp->inv_p == 0 || disp->render_mode == LV_DISPLAY_RENDER_MODE_FULL) return;
+
+        detail::update_layouts(disp);
+
+        m_areas.count = 0;
+        for (uint32_t i = 0; i < disp->inv_p; ++i) {
+            if (disp->inv_area_joined[i]) continue;
+            m_areas.areas[m_areas.count++] = disp->inv_areas[i];
+        }
+        const uint32_t in = m_areas.count;
+        const uint64_t dirty = m_areas.pixels();
+
+        if (m_tile_w > 0 && m_tile_h > 0) {
+            m_areas.coalesce_tiles(m_tile_w, m_tile_h, lv_display_get_horizontal_resolution(disp),
+                                   lv_display_get_vertical_resolution(disp));
+        }
+        if (m_merge) m_areas.merge_by_overhead(m_overhead);
+        if (m_max_rects) m_areas.cap_rects(m_max_rects);
+
+        const uint32_t out = m_areas.count;
+        for (uint32_t i = 0; i < out; ++i) {
+            disp->inv_areas[i] = m_areas.areas[i];
+            disp->inv_area_joined[i] = 0;
+        }
+        disp->inv_p = out;
+        const uint64_t render = m_areas.pixels();
+
+        ++m_stats.frames;
+        m_stats.last_in = in;
+        m_stats.last_out = out;
+        m_stats.last_dirty_px = static_cast<uint32_t>(dirty);
+        m_stats.last_render_px = static_cast<uint32_t>(render);
+        m_stats.dirty_px += dirty;
+        m_stats.render_px += render;
+        m_stats.areas_in += in;
+        m_stats.areas_out += out;
+    }
+
+public:
+    /// Attach to a display (nullptr = default display); no merging until configured
+    explicit RefreshPolicy(lv_display_t* display = nullptr) noexcept
+        : m_display(display ? display : lv_display_get_default()) {
+        if (m_display) {
+            lv_display_add_event_cb(m_display, &refr_start_cb, LV_EVENT_REFR_START, this);
+        }
+    }
+
+    ~RefreshPolicy() {
+        if (m_display) lv_display_remove_event_cb_with_user_data(m_display, &refr_start_cb, this);
+    }
+
+    RefreshPolicy(const RefreshPolicy&) = delete;
+    RefreshPolicy& operator=(const RefreshPolicy&) = delete;
+
+    /**
+     * @brief Join two areas if their bounding box is at most pct % larger
+     *
+     * 0 joins only when no pixel is added; 100 accepts twice the pixels.
+     */
+    RefreshPolicy& merge_overhead(uint32_t pct) noexcept {
+        m_overhead = pct;
+        m_merge = true;
+        return *this;
+    }
+
+    /// Coalesce areas on a grid of w x h pixel tiles (0 = off)
+    RefreshPolicy& tiles(int32_t w, int32_t h) noexcept {
+        m_tile_w = LV_MAX(w, 0);
+        m_tile_h = LV_MAX(h, 0);
+        return *this;
+    }
+
+    /// Render at most n areas per frame (0 = no cap)
+    RefreshPolicy& max_rects(uint32_t n) noexcept {
+        m_max_rects = n;
+        return *this;
+    }
+
+    /// Back to LVGL's default joining
+    RefreshPolicy& reset() noexcept {
+        m_merge = false;
+        m_overhead = 0;
+        m_tile_w = m_tile_h = 0;
+        m_max_rects = 0;
+        return *this;
+    }
+
+    /// Dirty-area statistics
+    [[nodiscard]] const RefreshStats& stats() const noexcept { return m_stats; }
+
+    /// Clear statistics
+    RefreshPolicy& reset_stats() noexcept {
+        m_stats = RefreshStats{};
+        return *this;
+    }
+
+    /// Print statistics with LV_LOG_USER
+    void log() const noexcept {
+        LV_LOG_USER("RefreshPolicy: frames=%u last %u->%u areas %u->%upx, overdraw=%u%% avg areas %u->%u",
+                    static_cast<unsigned>(m_stats.frames),
+                    static_cast<unsigned>(m_stats.last_in), static_cast<unsigned>(m_stats.last_out),
+                    static_cast<unsigned>(m_stats.last_dirty_px), static_cast<unsigned>(m_stats.last_render_px),
+                    static_cast<unsigned>(m_stats.overdraw()),
+                    static_cast<unsigned>(m_stats.frames ? m_stats.areas_in / m_stats.frames : 0),
+                    static_cast<unsigned>(m_stats.frames ? m_stats.areas_out / m_stats.frames : 0));
+    }
+};
+
+} // namespace lv
@@ -0,0 +1,227 @@
+#pragma once
+
+/**
+ * @file render_threads.hpp
+ * @brief Parallel software rendering: draw unit limit, core pinning and stats
+ *
+ * With an OS layer (LV_USE_OS = LV_OS_PTHREAD in lv_conf.h), lv_init()
+ * starts LV_DRAW_SW_DRAW_UNIT_CNT software draw units, each with its own
+ * render thread. Draw tasks of independent areas are then rendered in
+ * parallel. RenderThreads controls those threads at runtime:
+ *
+ * - limit(n): let only the first n units take tasks (n <= LV_DRAW_SW_DRAW_UNIT_CNT)
+ * - pin(first_core): bind unit i to core (first_core + i) % cores (Linux)
+ * - unit(i): tasks rendered and busy time per unit
+ *
+ * @code
+ * lv::init();
+ * lv::RenderThreads threads;
+ * threads.limit(3).pin(1);      // Keep core 0 for the UI thread
+ * // ...
+ * threads.log();
+ * @endcode
+ *
+ * Units are found by name ("SW") in LVGL's draw unit list; statistics come
+ * from wrapping each unit's dispatch_cb, so the busy time ends when the
+ * dispatcher next sees the unit idle (it is woken as soon as a task
+ * finishes). Only one RenderThreads should exist at a time.
+ */
+
+#include <lvgl.h>
+#include <src/core/lv_global.h>          // Draw unit list
+#include <src/draw/lv_draw_private.h>    // lv_draw_unit_t
+#if LV_USE_DRAW_SW
+#include <src/draw/sw/lv_draw_sw_private.h>  // lv_draw_sw_unit_t (task_act, thread)
+#endif
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#if LV_USE_OS == LV_OS_PTHREAD && defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#ifndef LV_DRAW_SW_DRAW_UNIT_CNT
+#define LV_DRAW_SW_DRAW_UNIT_CNT 1
+#endif
+
+namespace lv {
+
+/// Per-unit rendering statistics
+struct RenderUnitStats {
+    uint32_t tasks = 0;     ///< Draw tasks taken
+    uint64_t busy_us = 0;   ///< Time spent rendering
+    int32_t core = -1;      ///< Pinned core (-1 = not pinned)
+    bool enabled = true;    ///< Takes tasks (see RenderThreads::limit())
+};
+
+namespace detail {
+
+struct RenderUnitSlot {
+    lv_draw_unit_t* unit = nullptr;
+    int32_t (*original)(lv_draw_unit_t*, lv_layer_t*) = nullptr;
+    RenderUnitStats stats;
+    bool busy = false;
+    std::chrono::steady_clock::time_point start{};
+};
+
+inline RenderUnitSlot g_render_units[LV_DRAW_SW_DRAW_UNIT_CNT] = {};
+inline uint32_t g_render_unit_count = 0;
+
+} // namespace detail
+
+/**
+ * @brief Runtime control of LVGL's software render threads
+ */
+class RenderThreads {
+public:
+    /// Compile-time number of software draw units
+    static constexpr uint32_t MAX_UNITS = LV_DRAW_SW_DRAW_UNIT_CNT;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    using Slot = detail::RenderUnitSlot;
+
+    [[nodiscard]] static Slot* slot_of(lv_draw_unit_t* unit) noexcept {
+        for (uint32_t i = 0; i < detail::g_render_unit_count; ++i) {
+            if (detail::g_render_units[i].unit == unit) return &detail::g_render_units[i];
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] static bool unit_active(lv_draw_unit_t* unit) noexcept {
+#if LV_USE_DRAW_SW
+        return reinterpret_cast<lv_draw_sw_unit_t*>(unit)->task_act != nullptr;
+#else
+        (void)unit;
+        return false;
+#endif
+    }
+
+    static int32_t dispatch(lv_draw_unit_t* unit, lv_layer_t* layer) {
+        Slot* s = slot_of(unit);
+        if (!s) return LV_DRAW_UNIT_IDLE;
+        if (s->busy && !unit_active(unit)) {
+            s->busy = false;
+            s->stats.busy_us += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - s->start).count());
+        }
+        if (!s->stats.enabled) return LV_DRAW_UNIT_IDLE;
+
+        const int32_t taken = s->original(unit, layer);
+        if (taken > 0 && !s->busy && unit_active(unit)) {
+            ++s->stats.tasks;
+            s->busy = true;
+            s->start = Clock::now();
+        }
+        return taken;
+    }
+
+public:
+    /// Hook all software draw units (call after lv::init())
+    RenderThreads() noexcept {
+        detail::g_render_unit_count = 0;
+        for (lv_draw_unit_t* u = LV_GLOBAL_DEFAULT()->draw_info.unit_head; u; u = u->next) {
+            if (!u->name || std::strcmp(u->name, "SW") != 0 || detail::g_render_unit_count == MAX_UNITS) continue;
+            Slot& s = detail::g_render_units[detail::g_render_unit_count++];
+            s = Slot{};
+            s.unit = u;
+            s.original = u->dispatch_cb;
+            u->dispatch_cb = &dispatch;
+        }
+        if (LV_USE_OS == LV_OS_NONE) {
+            LV_LOG_WARN("RenderThreads: LV_USE_OS is LV_OS_NONE, rendering stays on the calling thread");
+        }
+    }
+
+    /// Restore the original dispatchers (all units take tasks again)
+    ~RenderThreads() {
+        for (uint32_t i = 0; i < detail::g_render_unit_count; ++i) {
+            detail::g_render_units[i].unit->dispatch_cb = detail::g_render_units[i].original;
+        }
+        detail::g_render_unit_count = 0;
+    }
+
+    RenderThreads(const RenderThreads&) = delete;
+    RenderThreads& operator=(const RenderThreads&) = delete;
+
+    /// Number of software draw units found
+    [[nodiscard]] uint32_t count() const noexcept { return detail::g_render_unit_count; }
+
+    /// Check if draw units run on their own threads
+    [[nodiscard]] static constexpr bool threaded() noexcept {
+        return LV_USE_OS != LV_OS_NONE;
+    }
+
+    /**
+     * @brief Use only the first n units (at least 1)
+     *
+     * The other threads stay parked; useful to leave cores to the
+     * application or to measure scaling.
+     */
+    RenderThreads& limit(uint32_t n) noexcept {
+        if (n == 0) n = 1;
+        for (uint32_t i = 0; i < detail::g_render_unit_count; ++i) {
+            detail::g_render_units[i].stats.enabled = i < n;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Pin unit i to core (first_core + i) % cores
+     *
+     * No-op (with a warning) without pthread software units on Linux.
+     */
+    RenderThreads& pin(uint32_t first_core = 0) noexcept {
+#if LV_USE_OS == LV_OS_PTHREAD && defined(__linux__) && LV_USE_DRAW_SW
+        const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        if (cores <= 0) return *this;
+        for (uint32_t i = 0; i < detail::g_render_unit_count; ++i) {
+            const int core = static_cast<int>((first_core + i) % static_cast<uint32_t>(cores));
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(core, &set);
+            auto* sw = reinterpret_cast<lv_draw_sw_unit_t*>(detail::g_render_units[i].unit);
+            if (pthread_setaffinity_np(sw->thread.thread, sizeof(set), &set) == 0) {
+                detail::g_render_units[i].stats.core = core;
+            } else {
+                LV_LOG_WARN("RenderThreads: can't pin unit %u to core %d", static_cast<unsigned>(i), core);
+            }
+        }
+#else
+        (void)first_core;
+        LV_LOG_WARN("RenderThreads: core pinning needs LV_OS_PTHREAD and software rendering on Linux");
+#endif
+        return *this;
+    }
+
+    /// Statistics of unit i
+    [[nodiscard]] RenderUnitStats unit(uint32_t i) const noexcept {
+        return i < detail::g_render_unit_count ? detail::g_render_units[i].stats : RenderUnitStats{};
+    }
+
+    /// Clear task counts and busy times
+    RenderThreads& reset_stats() noexcept {
+        for (uint32_t i = 0; i < detail::g_render_unit_count; ++i) {
+            detail::g_render_units[i].stats.tasks = 0;
+            detail::g_render_units[i].stats.busy_us = 0;
+        }
+        return *this;
+    }
+
+    /// Print per-unit statistics with LV_LOG_USER
+    void log() const noexcept {
+        for (uint32_t i = 0; i < detail::g_render_unit_count; ++i) {
+            [[maybe_unused]] const RenderUnitStats& s = detail::g_render_units[i].stats;
+            LV_LOG_USER("SW unit %u: %s core=%d tasks=%u busy=%ums",
+                        static_cast<unsigned>(i), s.enabled ? "on " : "off",
+                        static_cast<int>(s.core), static_cast<unsigned>(s.tasks),
+                        static_cast<unsigned>(s.busy_us / 1000));
+        }
+    }
+};
+
+} // namespace lv
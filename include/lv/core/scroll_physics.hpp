@@ -0,0 +1,393 @@
+#pragma once
+
+/**
+ * @file scroll_physics.hpp
+ * @brief Frame-rate independent kinetic scrolling
+ *
+ * LVGL's scroll throw multiplies the throw vector by (100 - scroll_throw)%
+ * on every indev read, so momentum depends on the indev period and stalls
+ * when reads are late. KineticScroll takes over at LV_EVENT_SCROLL_THROW_BEGIN
+ * and integrates the motion against elapsed time instead:
+ *
+ * - friction: exponential decay, v(t) = v0 * e^(-t / decel_ms)
+ * - spring: critically damped return to the nearest edge (elastic overscroll)
+ *   or to a page (ScrollMotion::page)
+ *
+ * Both use closed-form steps, so a 10 ms frame and a 40 ms frame land on the
+ * same curve. The position is applied once per frame, at LV_EVENT_REFR_START
+ * of the object's display, with a single lv_obj_scroll_by().
+ *
+ * @code
+ * lv::scroll_physics(tileview, {.motion = lv::ScrollMotion::page});
+ * lv::scroll_physics(list, {.decel_ms = 400});
+ * @endcode
+ *
+ * The release velocity is measured from the scroll positions of the last
+ * `velocity_window_ms` of the drag. LV_EVENT_SCROLL_END is sent when the
+ * motion stops, so Tileview and snap users see the usual event sequence.
+ *
+ * @note Only objects scrolled by LVGL's scroll logic are affected. Roller
+ * and other widgets that handle dragging themselves keep their own inertia.
+ */
+
+#include <lvgl.h>
+#include <cmath>
+#include <cstdint>
+#include <new>
+
+namespace lv {
+
+/// How a thrown scroll comes to rest
+enum class ScrollMotion : uint8_t {
+    friction,   ///< Decelerate freely, spring back at the edges
+    page,       ///< Settle on a page boundary (predicted from the throw)
+};
+
+/// Kinetic scroll parameters
+struct ScrollPhysics {
+    ScrollMotion motion = ScrollMotion::friction;
+    uint32_t decel_ms = 325;            ///< Friction time constant (velocity falls to 37% after this)
+    uint32_t spring_ms = 400;           ///< Approximate settle time of springs
+    int32_t min_velocity = 20;          ///< Stop below this speed (px/s)
+    int32_t page_size = 0;              ///< Page size for ScrollMotion::page (0 = content box size)
+    uint32_t velocity_window_ms = 80;   ///< Drag samples used for the release velocity
+};
+
+/**
+ * @brief Kinetic scroll engine attached to one scrollable object
+ *
+ * Allocated with lv_malloc() by attach() and freed when the object is
+ * deleted. Usually used through lv::scroll_physics().
+ */
+class KineticScroll {
+    static constexpr uint32_t HISTORY = 8;
+
+    struct Sample {
+        uint32_t time;
+        int32_t x;
+        int32_t y;
+    };
+
+    struct Axis {
+        bool active = false;
+        bool spring = false;
+        float pos = 0;        ///< Scroll position (lv_obj_get_scroll_x/y coordinates)
+        float vel = 0;        ///< px/s, positive = scroll position increasing
+        float target = 0;     ///< Spring rest position
+        float min = 0;
+        float max = 0;
+        int32_t applied = 0;  ///< Position last written to the object
+    };
+
+    lv_obj_t* m_obj;
+    lv_display_t* m_display = nullptr;  ///< Set while animating
+    ScrollPhysics m_phys;
+
+    Sample m_ring[HISTORY] = {};
+    uint32_t m_head = 0;
+    uint32_t m_count = 0;
+    lv_point_t m_drag_start{};
+    bool m_dragging = false;
+
+    Axis m_axis[2];                     ///< x, y
+    uint32_t m_last_tick = 0;
+
+    explicit KineticScroll(lv_obj_t* obj, const ScrollPhysics& phys) noexcept
+        : m_obj(obj), m_phys(phys) {}
+
+    [[nodiscard]] const Sample& at(uint32_t age) const noexcept {
+        return m_ring[(m_head - 1 - age) % HISTORY];
+    }
+
+    void sample() noexcept {
+        const uint32_t now = lv_tick_get();
+        const Sample s{now, lv_obj_get_scroll_x(m_obj), lv_obj_get_scroll_y(m_obj)};
+        if (m_count && at(0).time == now) {
+            m_ring[(m_head - 1) % HISTORY] = s;
+            return;
+        }
+        m_ring[m_head % HISTORY] = s;
+        ++m_head;
+        if (m_count < HISTORY) ++m_count;
+    }
+
+    /// Release velocity in px/s (scroll coordinates)
+    void release_velocity(float& vx, float& vy) const noexcept {
+        vx = vy = 0;
+        if (m_count < 2) return;
+        const Sample& newest = at(0);
+        if (lv_tick_elaps(newest.time) > m_phys.velocity_window_ms) return;  // Finger rested
+        const Sample* oldest = &at(1);
+        for (uint32_t age = 2; age < m_count; ++age) {
+            if (newest.time - at(age).time > m_phys.velocity_window_ms) break;
+            oldest = &at(age);
+        }
+        const auto dt = static_cast<float>(newest.time - oldest->time);
+        if (dt <= 0) return;
+        vx = static_cast<float>(newest.x - oldest->x) * 1000.0f / dt;
+        vy = static_cast<float>(newest.y - oldest->y) * 1000.0f / dt;
+    }
+
+    [[nodiscard]] float omega() const noexcept {
+        // Critically damped: within ~1% of the target after 6.6 / omega
+        return 6.6f * 1000.0f / static_cast<float>(m_phys.spring_ms ? m_phys.spring_ms : 1);
+    }
+
+    [[nodiscard]] float page_target(const Axis& a, int32_t start, int32_t content) const noexcept {
+        const float page = static_cast<float>(m_phys.page_size > 0 ? m_phys.page_size : content);
+        if (page <= 0) return a.pos;
+        // Where friction alone would stop, rounded to a page
+        const float rest = a.pos + a.vel * static_cast<float>(m_phys.decel_ms) / 1000.0f;
+        float target = a.min + std::round((rest - a.min) / page) * page;
+        if (lv_obj_has_flag(m_obj, LV_OBJ_FLAG_SCROLL_ONE)) {
+            const float from = a.min + std::round((static_cast<float>(start) - a.min) / page) * page;
+            target = LV_CLAMP(from - page, target, from + page);
+        }
+        return LV_CLAMP(a.min, target, a.max);
+    }
+
+    void start_axis(Axis& a, int32_t pos, int32_t before, int32_t after, float vel,
+                    int32_t drag_start, int32_t content) noexcept {
+        a.pos = static_cast<float>(pos);
+        a.applied = pos;
+        a.vel = vel;
+        a.min = static_cast<float>(pos - before);
+        a.max = static_cast<float>(pos + after);
+        a.active = true;
+        a.spring = false;
+        if (m_phys.motion == ScrollMotion::page) {
+            a.spring = true;
+            a.target = page_target(a, drag_start, content);
+        } else if (a.pos < a.min || a.pos > a.max) {
+            a.spring = true;
+            a.target = LV_CLAMP(a.min, a.pos, a.max);
+        }
+    }
+
+    /// Advance one axis by dt seconds (closed form, frame-rate independent)
+    void step(Axis& a, float dt) noexcept {
+        const float min_v = static_cast<float>(m_phys.min_velocity);
+        if (!a.spring) {
+            const float tau = static_cast<float>(m_phys.decel_ms ? m_phys.decel_ms : 1) / 1000.0f;
+            const float decay = std::exp(-dt / tau);
+            a.pos += a.vel * tau * (1.0f - decay);
+            a.vel *= decay;
+            if (a.pos < a.min || a.pos > a.max) {
+                if (lv_obj_has_flag(m_obj, LV_OBJ_FLAG_SCROLL_ELASTIC)) {
+                    // Carry the momentum into the edge spring
+                    a.spring = true;
+                    a.target = LV_CLAMP(a.min, a.pos, a.max);
+                } else {
+                    a.pos = LV_CLAMP(a.min, a.pos, a.max);
+                    a.active = false;
+                }
+            } else if (std::fabs(a.vel) < min_v) {
+                a.active = false;
+            }
+            return;
+        }
+        const float w = omega();
+        const float d = a.pos - a.target;
+        const float c = a.vel + w * d;
+        const float e = std::exp(-w * dt);
+        const float d1 = (d + c * dt) * e;
+        a.vel = (a.vel - w * c * dt) * e;
+        a.pos = a.target + d1;
+        if (std::fabs(d1) < 0.5f && std::fabs(a.vel) < min_v) {
+            a.pos = a.target;
+            a.active = false;
+        }
+    }
+
+    /// A pointer is pressed inside the object
+    [[nodiscard]] bool touched() const noexcept {
+        lv_area_t coords;
+        lv_obj_get_coords(m_obj, &coords);
+        for (lv_indev_t* indev = lv_indev_get_next(nullptr); indev; indev = lv_indev_get_next(indev)) {
+            if (lv_indev_get_type(indev) != LV_INDEV_TYPE_POINTER ||
+                lv_indev_get_state(indev) != LV_INDEV_STATE_PRESSED) {
+                continue;
+            }
+            lv_point_t p;
+            lv_indev_get_point(indev, &p);
+            if (lv_area_is_point_on(&coords, &p, 0)) return true;
+        }
+        return false;
+    }
+
+    void frame() noexcept {
+        if (touched()) {
+            // Catching a moving list stops it
+            halt();
+            return;
+        }
+        const uint32_t elapsed = lv_tick_elaps(m_last_tick);
+        if (elapsed == 0) return;
+        m_last_tick += elapsed;
+        const float dt = static_cast<float>(elapsed) / 1000.0f;
+
+        int32_t delta[2] = {0, 0};
+        for (uint32_t i = 0; i < 2; ++i) {
+            Axis& a = m_axis[i];
+            if (!a.active) continue;
+            step(a, dt);
+            const auto pos = static_cast<int32_t>(std::lround(a.pos));
+            delta[i] = pos - a.applied;
+            a.applied = pos;
+        }
+        if (delta[0] || delta[1]) {
+            // Unbounded on purpose: elastic overscroll is part of the motion
+            lv_obj_scroll_by(m_obj, -delta[0], -delta[1], LV_ANIM_OFF);
+        }
+        if (!m_axis[0].active && !m_axis[1].active) {
+            stop();
+            lv_obj_send_event(m_obj, LV_EVENT_SCROLL_END, nullptr);
+        }
+    }
+
+    void throw_begin(lv_indev_t* indev) noexcept {
+        float vx = 0;
+        float vy = 0;
+        release_velocity(vx, vy);
+        const lv_dir_t dir = indev ? lv_indev_get_scroll_dir(indev) : LV_DIR_ALL;
+        if (indev) {
+            // Cancel LVGL's per-read throw; this engine drives the motion from now on
+            lv_indev_reset(indev, m_obj);
+        }
+        m_dragging = false;
+
+        m_axis[0] = {};
+        m_axis[1] = {};
+        if (dir & LV_DIR_HOR) {
+            start_axis(m_axis[0], lv_obj_get_scroll_x(m_obj), lv_obj_get_scroll_left(m_obj),
+                       lv_obj_get_scroll_right(m_obj), vx, m_drag_start.x, lv_obj_get_content_width(m_obj));
+        }
+        if (dir & LV_DIR_VER) {
+            start_axis(m_axis[1], lv_obj_get_scroll_y(m_obj), lv_obj_get_scroll_top(m_obj),
+                       lv_obj_get_scroll_bottom(m_obj), vy, m_drag_start.y, lv_obj_get_content_height(m_obj));
+        }
+        start();
+    }
+
+    void start() noexcept {
+        if (m_display) return;
+        m_display = lv_obj_get_display(m_obj);
+        m_last_tick = lv_tick_get();
+        lv_display_add_event_cb(m_display, &refr_cb, LV_EVENT_REFR_START, this);
+    }
+
+    void stop() noexcept {
+        if (!m_display) return;
+        lv_display_remove_event_cb_with_user_data(m_display, &refr_cb, this);
+        m_display = nullptr;
+        m_axis[0].active = m_axis[1].active = false;
+    }
+
+    static void refr_cb(lv_event_t* e) {
+        static_cast<KineticScroll*>(lv_event_get_user_data(e))->frame();
+    }
+
+    static void obj_cb(lv_event_t* e) {
+        auto* self = static_cast<KineticScroll*>(lv_event_get_user_data(e));
+        switch (lv_event_get_code(e)) {
+        case LV_EVENT_SCROLL_BEGIN:
+            // Only the indev sends this (our motion scrolls without animation): a new drag
+            self->stop();
+            self->m_dragging = true;
+            self->m_count = 0;
+            self->m_drag_start = {lv_obj_get_scroll_x(self->m_obj), lv_obj_get_scroll_y(self->m_obj)};
+            self->sample();
+            break;
+        case LV_EVENT_SCROLL:
+            if (self->m_dragging) self->sample();
+            break;
+        case LV_EVENT_SCROLL_THROW_BEGIN:
+            self->throw_begin(lv_indev_active());
+            break;
+        case LV_EVENT_DELETE:
+            self->stop();
+            self->~KineticScroll();
+            lv_free(self);
+            break;
+        default:
+            break;
+        }
+    }
+
+public:
+    KineticScroll(const KineticScroll&) = delete;
+    KineticScroll& operator=(const KineticScroll&) = delete;
+
+    /// Find the engine attached to obj, or nullptr
+    [[nodiscard]] static KineticScroll* find(lv_obj_t* obj) noexcept {
+        const uint32_t n = lv_obj_get_event_count(obj);
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_event_dsc_t* dsc = lv_obj_get_event_dsc(obj, i);
+            if (lv_event_dsc_get_cb(dsc) == &obj_cb) {
+                return static_cast<KineticScroll*>(lv_event_dsc_get_user_data(dsc));
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Attach (or reconfigure) kinetic scrolling on obj
+     *
+     * @return The engine, or nullptr if out of memory
+     */
+    static KineticScroll* attach(lv_obj_t* obj, const ScrollPhysics& phys = {}) noexcept {
+        if (KineticScroll* ks = find(obj)) {
+            ks->m_phys = phys;
+            return ks;
+        }
+        void* mem = lv_malloc(sizeof(KineticScroll));
+        if (!mem) {
+            LV_LOG_WARN("KineticScroll: out of memory");
+            return nullptr;
+        }
+        auto* ks = new (mem) KineticScroll(obj, phys);
+        lv_obj_add_event_cb(obj, &obj_cb, LV_EVENT_ALL, ks);
+        return ks;
+    }
+
+    /// Remove kinetic scrolling from obj (LVGL's scroll throw applies again)
+    static void detach(lv_obj_t* obj) noexcept {
+        KineticScroll* ks = find(obj);
+        if (!ks) return;
+        ks->stop();
+        lv_obj_remove_event_cb_with_user_data(obj, &obj_cb, ks);
+        ks->~KineticScroll();
+        lv_free(ks);
+    }
+
+    /// Get the parameters
+    [[nodiscard]] const ScrollPhysics& physics() const noexcept { return m_phys; }
+
+    /// Check if a throw is in progress
+    [[nodiscard]] bool moving() const noexcept { return m_display != nullptr; }
+
+    /// Stop the current motion where it is
+    void halt() noexcept {
+        if (!m_display) return;
+        stop();
+        lv_obj_send_event(m_obj, LV_EVENT_SCROLL_END, nullptr);
+    }
+};
+
+/**
+ * @brief Replace LVGL's scroll throw on an object with frame-rate independent physics
+ *
+ * Calling it again replaces the parameters.
+ *
+ * @return The engine, or nullptr if out of memory
+ */
+inline KineticScroll* scroll_physics(lv_obj_t* obj, const ScrollPhysics& physics = {}) noexcept {
+    return KineticScroll::attach(obj, physics);
+}
+
+/// Restore LVGL's own scroll throw on an object
+inline void remove_scroll_physics(lv_obj_t* obj) noexcept {
+    KineticScroll::detach(obj);
+}
+
+} // namespace lv
@@ -0,0 +1,347 @@
+#pragma once
+
+/**
+ * @file spatial_focus.hpp
+ * @brief Directional (left/right/up/down) focus moves for focus groups
+ *
+ * lv_group_focus_next()/prev() follow insertion order. For D-pad and
+ * encoder navigation on grids, focus should move to the nearest object in
+ * a direction instead. SpatialFocus keeps a uniform grid over the centers
+ * of a group's focusable objects, so a move only looks at the cells around
+ * the focused object, ring by ring, until no closer candidate is possible.
+ *
+ * @code
+ * lv::FocusGroup group;
+ * // ... add buttons of a grid ...
+ * lv::SpatialFocus nav(group);
+ *
+ * nav.move(lv::kDir::right);
+ * nav.handle_key(lv::key::down);   // Arrow keys map to move()
+ * @endcode
+ *
+ * Candidates are ranked by distance along the direction plus twice the
+ * perpendicular offset (center to center), so the object straight ahead
+ * wins over a closer one off to the side.
+ *
+ * The index is rebuilt lazily on the next move after the group's object
+ * count changes, or after a layout, size or scroll change of a container
+ * holding group members. Call invalidate() after moving objects by hand.
+ */
+
+#include <lvgl.h>
+#include "focus.hpp"
+#include <cstdint>
+
+namespace lv {
+
+/**
+ * @brief Grid-bucketed spatial index over a focus group
+ *
+ * Non-movable (registered as event callback on member containers with `this`).
+ */
+class SpatialFocus {
+    static constexpr uint32_t MAX_WATCHED = 8;   ///< Member containers watched for layout changes
+
+    struct Item {
+        lv_obj_t* obj;
+        int32_t x;   ///< Center (screen coordinates)
+        int32_t y;
+    };
+
+    lv_group_t* m_group;
+    int32_t m_cell_cfg;                 ///< Requested cell size (0 = automatic)
+
+    Item* m_items = nullptr;            ///< Sorted by cell
+    uint32_t* m_cell_start = nullptr;   ///< Items of cell c: [m_cell_start[c], m_cell_start[c + 1])
+    uint32_t m_count = 0;
+    uint32_t m_group_count = 0;         ///< Group size when built
+    int32_t m_cell = 1;
+    int32_t m_cols = 0;
+    int32_t m_rows = 0;
+    int32_t m_x0 = 0;
+    int32_t m_y0 = 0;
+    bool m_dirty = true;
+
+    lv_obj_t* m_watched[MAX_WATCHED] = {};
+
+    [[nodiscard]] static lv_point_t center_of(lv_obj_t* obj) noexcept {
+        lv_area_t a;
+        lv_obj_get_coords(obj, &a);
+        return {(a.x1 + a.x2) / 2, (a.y1 + a.y2) / 2};
+    }
+
+    [[nodiscard]] static bool focusable(lv_obj_t* obj) noexcept {
+        return !lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) && !lv_obj_has_state(obj, LV_STATE_DISABLED);
+    }
+
+    [[nodiscard]] int32_t col_of(int32_t x) const noexcept {
+        return LV_CLAMP(0, (x - m_x0) / m_cell, m_cols - 1);
+    }
+
+    [[nodiscard]] int32_t row_of(int32_t y) const noexcept {
+        return LV_CLAMP(0, (y - m_y0) / m_cell, m_rows - 1);
+    }
+
+    // ---- Change tracking ----
+
+    static void watch_cb(lv_event_t* e) {
+        auto* self = static_cast<SpatialFocus*>(lv_event_get_user_data(e));
+        self->m_dirty = true;
+        if (lv_event_get_code(e) == LV_EVENT_DELETE) {
+            lv_obj_t* obj = lv_event_get_current_target_obj(e);
+            for (auto& w : self->m_watched) {
+                if (w == obj) w = nullptr;
+            }
+        }
+    }
+
+    void watch(lv_obj_t* parent) noexcept {
+        for (auto* w : m_watched) {
+            if (w == parent) return;
+        }
+        for (auto& w : m_watched) {
+            if (!w) {
+                w = parent;
+                lv_obj_add_event_cb(parent, &watch_cb, LV_EVENT_LAYOUT_CHANGED, this);
+                lv_obj_add_event_cb(parent, &watch_cb, LV_EVENT_SIZE_CHANGED, this);
+                lv_obj_add_event_cb(parent, &watch_cb, LV_EVENT_SCROLL, this);
+                lv_obj_add_event_cb(parent, &watch_cb, LV_EVENT_DELETE, this);
+                return;
+            }
+        }
+        // More containers than slots: moves still verify the chosen object's position
+    }
+
+    void unwatch_all() noexcept {
+        for (auto& w : m_watched) {
+            if (w) {
+                lv_obj_remove_event_cb_with_user_data(w, &watch_cb, this);
+                w = nullptr;
+            }
+        }
+    }
+
+    void release() noexcept {
+        if (m_items) lv_free(m_items);
+        if (m_cell_start) lv_free(m_cell_start);
+        m_items = nullptr;
+        m_cell_start = nullptr;
+        m_count = 0;
+        m_cols = m_rows = 0;
+    }
+
+    // ---- Build ----
+
+    bool rebuild() noexcept {
+        unwatch_all();
+        release();
+        m_dirty = false;
+        m_group_count = lv_group_get_obj_count(m_group);
+        if (m_group_count == 0) return true;
+
+        auto* items = static_cast<Item*>(lv_malloc(sizeof(Item) * m_group_count));
+        if (!items) {
+            LV_LOG_WARN("SpatialFocus: out of memory");
+            m_dirty = true;
+            return false;
+        }
+
+        // Collect centers and the bounding box
+        int32_t x1 = INT32_MAX, y1 = INT32_MAX, x2 = INT32_MIN, y2 = INT32_MIN;
+        int64_t size_sum = 0;
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < m_group_count; ++i) {
+            lv_obj_t* obj = lv_group_get_obj_by_index(m_group, i);
+            if (!obj || !focusable(obj)) continue;
+            lv_area_t a;
+            lv_obj_get_coords(obj, &a);
+            const Item it{obj, (a.x1 + a.x2) / 2, (a.y1 + a.y2) / 2};
+            items[n++] = it;
+            x1 = LV_MIN(x1, it.x);
+            y1 = LV_MIN(y1, it.y);
+            x2 = LV_MAX(x2, it.x);
+            y2 = LV_MAX(y2, it.y);
+            size_sum += lv_area_get_width(&a) + lv_area_get_height(&a);
+            if (lv_obj_t* parent = lv_obj_get_parent(obj)) watch(parent);
+        }
+        if (n == 0) {
+            lv_free(items);
+            return true;
+        }
+
+        // About one object per cell; cap the cell count for sparse layouts
+        m_cell = m_cell_cfg > 0 ? m_cell_cfg : static_cast<int32_t>(LV_MAX(size_sum / (2 * n), 8));
+        const int64_t max_cells = 4 * static_cast<int64_t>(n) + 16;
+        while ((static_cast<int64_t>(x2 - x1) / m_cell + 1) * ((y2 - y1) / m_cell + 1) > max_cells) {
+            m_cell *= 2;
+        }
+        m_x0 = x1;
+        m_y0 = y1;
+        m_cols = (x2 - x1) / m_cell + 1;
+        m_rows = (y2 - y1) / m_cell + 1;
+        const uint32_t cells = static_cast<uint32_t>(m_cols * m_rows);
+
+        m_items = static_cast<Item*>(lv_malloc(sizeof(Item) * n));
+        m_cell_start = static_cast<uint32_t*>(lv_malloc(sizeof(uint32_t) * (cells + 1)));
+        if (!m_items || !m_cell_start) {
+            LV_LOG_WARN("SpatialFocus: out of memory");
+            lv_free(items);
+            release();
+            m_dirty = true;
+            return false;
+        }
+
+        // Counting sort by cell
+        lv_memzero(m_cell_start, sizeof(uint32_t) * (cells + 1));
+        for (uint32_t i = 0; i < n; ++i) {
+            ++m_cell_start[row_of(items[i].y) * m_cols + col_of(items[i].x) + 1];
+        }
+        for (uint32_t c = 0; c < cells; ++c) m_cell_start[c + 1] += m_cell_start[c];
+        for (uint32_t i = 0; i < n; ++i) {
+            // m_cell_start[c] is used as the insert cursor, then shifted back below
+            const uint32_t c = static_cast<uint32_t>(row_of(items[i].y) * m_cols + col_of(items[i].x));
+            m_items[m_cell_start[c]++] = items[i];
+        }
+        for (uint32_t c = cells; c > 0; --c) m_cell_start[c] = m_cell_start[c - 1];
+        m_cell_start[0] = 0;
+
+        lv_free(items);
+        m_count = n;
+        return true;
+    }
+
+    // ---- Query ----
+
+    /// Best candidate by scanning rings of cells around `from`
+    [[nodiscard]] const Item* search(lv_obj_t* from, lv_point_t f, lv_dir_t dir) const noexcept {
+        if (!m_count) return nullptr;
+        const int32_t fc = col_of(f.x);
+        const int32_t fr = row_of(f.y);
+        const Item* best = nullptr;
+        int64_t best_score = INT64_MAX;
+
+        auto visit = [&](int32_t col, int32_t row) {
+            if (col < 0 || row < 0 || col >= m_cols || row >= m_rows) return;
+            // Only the half-plane in the direction of the move
+            if ((dir == LV_DIR_RIGHT && col < fc) || (dir == LV_DIR_LEFT && col > fc) ||
+                (dir == LV_DIR_BOTTOM && row < fr) || (dir == LV_DIR_TOP && row > fr)) {
+                return;
+            }
+            const uint32_t c = static_cast<uint32_t>(row * m_cols + col);
+            for (uint32_t i = m_cell_start[c]; i < m_cell_start[c + 1]; ++i) {
+                const Item& it = m_items[i];
+                if (it.obj == from) continue;
+                int32_t along = 0;
+                int32_t across = 0;
+                switch (dir) {
+                case LV_DIR_RIGHT:  along = it.x - f.x; across = it.y - f.y; break;
+                case LV_DIR_LEFT:   along = f.x - it.x; across = it.y - f.y; break;
+                case LV_DIR_BOTTOM: along = it.y - f.y; across = it.x - f.x; break;
+                default:            along = f.y - it.y; across = it.x - f.x; break;
+                }
+                if (along <= 0) continue;
+                const int64_t score = static_cast<int64_t>(along) + 2 * static_cast<int64_t>(LV_ABS(across));
+                if (score < best_score) {
+                    best_score = score;
+                    best = &it;
+                }
+            }
+        };
+
+        const int32_t max_r = LV_MAX(m_cols, m_rows);
+        for (int32_t r = 0; r <= max_r; ++r) {
+            // Everything in ring r is at least (r - 1) cells away along one axis
+            if (r > 0 && static_cast<int64_t>(r - 1) * m_cell > best_score) break;
+            for (int32_t dc = -r; dc <= r; ++dc) {
+                visit(fc + dc, fr - r);
+                if (r > 0) visit(fc + dc, fr + r);
+            }
+            for (int32_t dr = -r + 1; dr <= r - 1; ++dr) {
+                visit(fc - r, fr + dr);
+                visit(fc + r, fr + dr);
+            }
+        }
+        return best;
+    }
+
+public:
+    /**
+     * @brief Index the objects of a focus group
+     *
+     * @param group Focus group (lv_group_t* or FocusGroup)
+     * @param cell_size Grid cell size in px (0 = average object size)
+     */
+    explicit SpatialFocus(lv_group_t* group, int32_t cell_size = 0) noexcept
+        : m_group(group), m_cell_cfg(cell_size) {}
+
+    ~SpatialFocus() {
+        unwatch_all();
+        release();
+    }
+
+    SpatialFocus(const SpatialFocus&) = delete;
+    SpatialFocus& operator=(const SpatialFocus&) = delete;
+
+    /// Rebuild the index on the next query
+    SpatialFocus& invalidate() noexcept {
+        m_dirty = true;
+        return *this;
+    }
+
+    /**
+     * @brief Find the nearest group object in a direction
+     *
+     * @param from Reference object (usually the focused one)
+     * @param dir kDir::left, right, top or bottom
+     * @return The object, or nullptr if there is none in that direction
+     */
+    [[nodiscard]] lv_obj_t* find(lv_obj_t* from, lv_dir_t dir) noexcept {
+        if (!from) return nullptr;
+        if (m_dirty || lv_group_get_obj_count(m_group) != m_group_count) {
+            if (!rebuild()) return nullptr;
+        }
+        const lv_point_t f = center_of(from);
+        const Item* best = search(from, f, dir);
+        if (best) {
+            // Objects moved without a watched event (e.g. set_pos): rebuild once
+            const lv_point_t c = center_of(best->obj);
+            if (c.x != best->x || c.y != best->y) {
+                if (!rebuild()) return nullptr;
+                best = search(from, f, dir);
+            }
+        }
+        return best ? best->obj : nullptr;
+    }
+
+    /**
+     * @brief Move focus in a direction
+     *
+     * @return true if the focus moved
+     */
+    bool move(lv_dir_t dir) noexcept {
+        lv_obj_t* target = find(lv_group_get_focused(m_group), dir);
+        if (!target) return false;
+        lv_group_focus_obj(target);
+        return true;
+    }
+
+    /**
+     * @brief Move focus for an arrow key
+     *
+     * @return true if the key was an arrow and the focus moved
+     */
+    bool handle_key(uint32_t key) noexcept {
+        switch (key) {
+        case LV_KEY_LEFT:  return move(LV_DIR_LEFT);
+        case LV_KEY_RIGHT: return move(LV_DIR_RIGHT);
+        case LV_KEY_UP:    return move(LV_DIR_TOP);
+        case LV_KEY_DOWN:  return move(LV_DIR_BOTTOM);
+        default:           return false;
+        }
+    }
+
+    /// Number of indexed objects (as of the last build)
+    [[nodiscard]] uint32_t size() const noexcept { return m_count; }
+};
+
+} // namespace lv
@@ -0,0 +1,247 @@
+#pragma once
+
+/**
+ * @file tiled_renderer.hpp
+ * @brief Tile-based partial rendering with bounded draw-buffer memory
+ *
+ * In partial mode LVGL renders a dirty area in strips as wide as the area:
+ * with one strip buffer on a 1280 px panel, each pass covers only a few
+ * full-width rows. TiledRenderer gives the display small tile buffers and
+ * cuts every dirty area into column bands on a tile_w grid before each
+ * refresh. LVGL then renders each band top to bottom in tile_w x tile_h
+ * pieces, so:
+ *
+ * - Each pass touches a cache-sized block (e.g. 128 x 64 x 4 B = 32 KB)
+ * - Draw units only see the tasks of that tile
+ * - Draw-buffer memory is buffers x tile size, independent of the panel
+ * - With 2 buffers, one tile renders while the previous one is flushed
+ *
+ * @code
+ * lv::TiledRenderer tiles(display, {.tile_w = 128, .tile_h = 64});
+ * lv::AsyncFlush async(display, LV_DISPLAY_RENDER_MODE_PARTIAL, tiles.tile_bytes());  // Optional
+ * @endcode
+ *
+ * Areas are rendered top to bottom, bands left to right. When a frame has
+ * more bands than LVGL's dirty list holds, bands get wider (tiles
+ * shorter); memory stays the same. Create a RefreshPolicy before the
+ * TiledRenderer so its merging runs first.
+ */
+
+#include <lvgl.h>
+#include "refresh_policy.hpp"
+#include <cstdint>
+
+namespace lv {
+
+/// TiledRenderer options
+struct TileConfig {
+    int32_t tile_w = 128;      ///< Tile (band) width in pixels
+    int32_t tile_h = 64;       ///< Tile height in pixels (sets the buffer size)
+    uint8_t buffers = 2;       ///< Tile buffers (2 = render while flushing)
+};
+
+/// Tiling statistics
+struct TileStats {
+    uint32_t frames = 0;       ///< Refreshes with dirty areas
+    uint32_t last_bands = 0;   ///< Bands of the last frame
+    uint32_t last_tiles = 0;   ///< Render passes of the last frame
+    uint64_t tiles = 0;        ///< Render passes in total
+};
+
+/**
+ * @brief Renders a display's dirty areas tile by tile
+ *
+ * Replaces the display's draw buffers and switches it to partial mode; the
+ * destructor restores both. Non-movable (registered as display event
+ * callback with `this` as user data). Destroy before the display is deleted.
+ */
+class TiledRenderer {
+public:
+    /// Capacity of LVGL's dirty list
+    static constexpr uint32_t MAX_AREAS = LV_INV_BUF_SIZE;
+
+private:
+    lv_display_t* m_display = nullptr;
+    TileConfig m_cfg;
+    uint32_t m_tile_bytes = 0;
+    void* m_bufs[2] = {};
+    lv_draw_buf_t m_draw_bufs[2] = {};   ///< Installed instead of the display's own
+    lv_draw_buf_t* m_saved_buf[2] = {};
+    lv_display_render_mode_t m_saved_mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+    TileStats m_stats;
+
+    lv_area_t m_areas[MAX_AREAS];
+    uint32_t m_count = 0;
+
+    [[nodiscard]] static uint64_t size_of(const lv_area_t& a) noexcept {
+        return static_cast<uint64_t>(lv_area_get_width(&a)) * static_cast<uint64_t>(lv_area_get_height(&a));
+    }
+
+    /// Join overlapping areas where that is cheaper, as LVGL would later
+    void join_overlapping() noexcept {
+        bool joined = true;
+        while (joined) {
+            joined = false;
+            for (uint32_t i = 0; i < m_count && !joined; ++i) {
+                for (uint32_t j = i + 1; j < m_count; ++j) {
+                    const lv_area_t& a = m_areas[i];
+                    const lv_area_t& b = m_areas[j];
+                    if (a.x1 > b.x2 || b.x1 > a.x2 || a.y1 > b.y2 || b.y1 > a.y2) continue;
+                    const lv_area_t u{LV_MIN(a.x1, b.x1), LV_MIN(a.y1, b.y1), LV_MAX(a.x2, b.x2), LV_MAX(a.y2, b.y2)};
+                    if (size_of(u) < size_of(a) + size_of(b)) {
+                        m_areas[i] = u;
+                        m_areas[j] = m_areas[--m_count];
+                        joined = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /// Top to bottom, then left to right
+    void sort_areas() noexcept {
+        for (uint32_t i = 1; i < m_count; ++i) {
+            const lv_area_t a = m_areas[i];
+            uint32_t j = i;
+            while (j > 0 && (m_areas[j - 1].y1 > a.y1 || (m_areas[j - 1].y1 == a.y1 && m_areas[j - 1].x1 > a.x1))) {
+                m_areas[j] = m_areas[j - 1];
+                --j;
+            }
+            m_areas[j] = a;
+        }
+    }
+
+    [[nodiscard]] uint32_t band_count(int32_t bw) const noexcept {
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < m_count; ++i) {
+            n += static_cast<uint32_t>(m_areas[i].x2 / bw - m_areas[i].x1 / bw + 1);
+        }
+        return n;
+    }
+
+    static void refr_start_cb(lv_event_t* e) {
+        static_cast<TiledRenderer*>(lv_event_get_user_data(e))->split();
+    }
+
+    void split() noexcept {
+        lv_display_t* disp = m_display;
+        if (disp->inv_p == 0) return;
+        detail::update_layouts(disp);
+
+        m_count = 0;
+        for (uint32_t i = 0; i < disp->inv_p; ++i) {
+            if (!disp->inv_area_joined[i]) m_areas[m_count++] = disp->inv_areas[i];
+        }
+        join_overlapping();
+        sort_areas();
+
+        // Widen bands until the frame fits LVGL's dirty list
+        const int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+        int32_t bw = m_cfg.tile_w;
+        while (bw < hor_res && band_count(bw) > MAX_AREAS) bw *= 2;
+
+        const lv_color_format_t cf = lv_display_get_color_format(disp);
+        uint32_t n = 0;
+        uint32_t tiles = 0;
+        for (uint32_t i = 0; i < m_count; ++i) {
+            const lv_area_t a = m_areas[i];
+            for (int32_t x = a.x1; x <= a.x2; x = (x / bw + 1) * bw) {
+                const lv_area_t band{x, a.y1, LV_MIN((x / bw + 1) * bw - 1, a.x2), a.y2};
+                const uint32_t rows = LV_MAX(m_tile_bytes / lv_draw_buf_width_to_stride(lv_area_get_width(&band), cf), 1u);
+                tiles += (static_cast<uint32_t>(lv_area_get_height(&band)) + rows - 1) / rows;
+                disp->inv_areas[n] = band;
+                disp->inv_area_joined[n] = 0;
+                ++n;
+            }
+        }
+        disp->inv_p = n;
+
+        ++m_stats.frames;
+        m_stats.last_bands = n;
+        m_stats.last_tiles = tiles;
+        m_stats.tiles += tiles;
+    }
+
+public:
+    /**
+     * @brief Switch a display to tiled partial rendering
+     *
+     * @param display Display to tile (nullptr = default display)
+     * @param cfg Tile size and buffer count
+     */
+    explicit TiledRenderer(lv_display_t* display = nullptr, const TileConfig& cfg = {}) noexcept
+        : m_cfg(cfg) {
+        if (!display) display = lv_display_get_default();
+        if (!display) return;
+        m_cfg.tile_w = LV_MAX(m_cfg.tile_w, 8);
+        m_cfg.tile_h = LV_MAX(m_cfg.tile_h, 1);
+
+        // A tile buffer must hold at least one full row for areas that aren't split
+        const lv_color_format_t cf = lv_display_get_color_format(display);
+        const uint32_t row = lv_draw_buf_width_to_stride(lv_display_get_horizontal_resolution(display), cf);
+        m_tile_bytes = LV_MAX(lv_draw_buf_width_to_stride(m_cfg.tile_w, cf) * m_cfg.tile_h, row);
+
+        const uint32_t count = m_cfg.buffers >= 2 ? 2 : 1;
+        const uint32_t w = static_cast<uint32_t>(lv_display_get_horizontal_resolution(display));
+        for (uint32_t i = 0; i < count; ++i) {
+            m_bufs[i] = lv_malloc(m_tile_bytes + LV_DRAW_BUF_ALIGN - 1);
+            if (!m_bufs[i]) {
+                LV_LOG_WARN("TiledRenderer: out of memory for tile buffers");
+                for (void*& b : m_bufs) {
+                    lv_free(b);
+                    b = nullptr;
+                }
+                return;
+            }
+            // Own draw buffers: lv_display_set_buffers() would re-initialize the
+            // display's static ones, which the saved buffers may point to
+            lv_draw_buf_init(&m_draw_bufs[i], w, m_tile_bytes / row, cf, row, lv_draw_buf_align(m_bufs[i], cf),
+                             m_tile_bytes);
+            m_draw_bufs[i].unaligned_data = m_bufs[i];
+        }
+
+        m_display = display;
+        m_saved_buf[0] = display->buf_1;
+        m_saved_buf[1] = display->buf_2;
+        m_saved_mode = display->render_mode;
+        lv_display_set_draw_buffers(display, &m_draw_bufs[0], count == 2 ? &m_draw_bufs[1] : nullptr);
+        lv_display_set_render_mode(display, LV_DISPLAY_RENDER_MODE_PARTIAL);
+        lv_display_add_event_cb(display, &refr_start_cb, LV_EVENT_REFR_START, this);
+    }
+
+    /// Give the display its own buffers and render mode back
+    ~TiledRenderer() {
+        if (m_display) {
+            lv_display_remove_event_cb_with_user_data(m_display, &refr_start_cb, this);
+            lv_display_set_draw_buffers(m_display, m_saved_buf[0], m_saved_buf[1]);
+            lv_display_set_render_mode(m_display, m_saved_mode);
+            lv_obj_invalidate(lv_display_get_screen_active(m_display));
+        }
+        for (void* b : m_bufs) lv_free(b);
+    }
+
+    TiledRenderer(const TiledRenderer&) = delete;
+    TiledRenderer& operator=(const TiledRenderer&) = delete;
+
+    /// Bytes per tile buffer
+    [[nodiscard]] uint32_t tile_bytes() const noexcept { return m_tile_bytes; }
+
+    /// Total draw-buffer memory (buffers x tile size)
+    [[nodiscard]] uint32_t memory() const noexcept {
+        return m_tile_bytes * (m_bufs[1] ? 2 : (m_bufs[0] ? 1 : 0));
+    }
+
+    /// Tiling statistics
+    [[nodiscard]] const TileStats& stats() const noexcept { return m_stats; }
+
+    /// Print statistics with LV_LOG_USER
+    void log() const noexcept {
+        LV_LOG_USER("TiledRenderer: %dx%d tiles, %uKB buffers, frames=%u last %u bands/%u tiles",
+                    static_cast<int>(m_cfg.tile_w), static_cast<int>(m_cfg.tile_h),
+                    static_cast<unsigned>(memory() / 1024), static_cast<unsigned>(m_stats.frames),
+                    static_cast<unsigned>(m_stats.last_bands), static_cast<unsigned>(m_stats.last_tiles));
+    }
+};
+
+} // namespace lv
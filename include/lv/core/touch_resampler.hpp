@@ -0,0 +1,286 @@
+#pragma once
+
+/**
+ * @file touch_resampler.hpp
+ * @brief Touch sample resampling and short-term prediction
+ *
+ * Scroll and drag use the raw point of each indev read. When the touch
+ * controller and the display both run at ~60 Hz they beat against each
+ * other: some frames see two new samples, some none, and motion judders.
+ * The finger also leads the rendered content by at least one frame.
+ *
+ * TouchResampler is an opt-in stage on a pointer indev. It keeps every raw
+ * sample with the time it was taken in a small ring and reports the
+ * position the finger had at a fixed time offset (`latency_ms`) before the
+ * read, interpolated between the samples around it. This turns irregular
+ * sample arrival into evenly spaced motion. With `predict_ms` > 0 the
+ * position is extrapolated forward from the last two samples (bounded by
+ * `max_predict_ms`) to hide part of the pipeline latency.
+ *
+ * While the pointer is pressed, the indev is also read at the start of
+ * every display refresh, so each rendered frame uses the position
+ * evaluated at its own render time.
+ *
+ * @code
+ * lv::EventIndev touch;
+ * touch.open_evdev("/dev/input/event0");
+ * lv::TouchResampler resampler(touch, {.latency_ms = 4, .predict_ms = 8});
+ * @endcode
+ *
+ * Sample times come from EventIndev (stamped when the reader thread
+ * pushed them) when attached to one; for polled indevs the read time is
+ * the sample time. Press and release points are passed through unchanged
+ * so clicks land exactly where the finger touched.
+ */
+
+#include <lvgl.h>
+#include "indev_tap.hpp"
+#include "event_indev.hpp"
+#include <cstdint>
+
+namespace lv {
+
+/// Resampling parameters (all in milliseconds)
+struct ResampleConfig {
+    uint32_t latency_ms = 5;       ///< Resample this far in the past (interpolation window)
+    uint32_t predict_ms = 0;       ///< Extrapolate this far ahead (0 = interpolate only)
+    uint32_t max_predict_ms = 8;   ///< Never extrapolate further beyond the newest sample
+    uint32_t max_gap_ms = 32;      ///< Samples further apart are not interpolated
+};
+
+namespace detail {
+
+/**
+ * @brief Timestamped pointer samples of one stroke and the resampling math
+ *
+ * @tparam History Number of samples kept (power of two)
+ */
+template<size_t History>
+class TouchHistory {
+    static_assert((History & (History - 1)) == 0 && History >= 2,
+        "History must be a power of two");
+
+    struct Sample {
+        uint32_t time;
+        int32_t x;
+        int32_t y;
+    };
+
+    Sample m_ring[History] = {};
+    uint32_t m_count = 0;    ///< Samples kept (saturates at History)
+    uint32_t m_head = 0;     ///< Index of the next write
+
+    [[nodiscard]] const Sample& at(uint32_t age) const noexcept {
+        // age 0 = newest
+        return m_ring[(m_head - 1 - age) & (History - 1)];
+    }
+
+    static int32_t lerp(int32_t a, int32_t b, int32_t num, int32_t den) noexcept {
+        return a + static_cast<int32_t>((static_cast<int64_t>(b - a) * num) / den);
+    }
+
+public:
+    /// Number of samples kept
+    [[nodiscard]] uint32_t size() const noexcept { return m_count; }
+
+    /// Forget all samples
+    void clear() noexcept { m_count = 0; }
+
+    /// Add a sample taken at time t (a repeated time replaces the newest sample)
+    void add(uint32_t t, lv_point_t p) noexcept {
+        if (m_count && at(0).time == t) {
+            m_ring[(m_head - 1) & (History - 1)] = {t, p.x, p.y};
+            return;
+        }
+        m_ring[m_head & (History - 1)] = {t, p.x, p.y};
+        ++m_head;
+        if (m_count < History) ++m_count;
+    }
+
+    /// Position at `now - latency_ms + predict_ms` (needs at least one sample)
+    [[nodiscard]] lv_point_t resample(uint32_t now, const ResampleConfig& cfg) const noexcept {
+        const Sample& newest = at(0);
+        // No sample for a while: the pointer is resting there
+        if (static_cast<int32_t>(now - newest.time) > static_cast<int32_t>(cfg.max_gap_ms)) {
+            return {newest.x, newest.y};
+        }
+        const uint32_t t = now - cfg.latency_ms + cfg.predict_ms;
+        const int32_t ahead = static_cast<int32_t>(t - newest.time);
+
+        if (ahead >= 0) {
+            // Extrapolate from the last two samples
+            if (m_count < 2 || ahead == 0) return {newest.x, newest.y};
+            const Sample& prev = at(1);
+            const int32_t dt = static_cast<int32_t>(newest.time - prev.time);
+            if (dt <= 0 || dt > static_cast<int32_t>(cfg.max_gap_ms)) return {newest.x, newest.y};
+            const int32_t by = LV_MIN(ahead, static_cast<int32_t>(cfg.max_predict_ms));
+            return {newest.x + static_cast<int32_t>((static_cast<int64_t>(newest.x - prev.x) * by) / dt),
+                    newest.y + static_cast<int32_t>((static_cast<int64_t>(newest.y - prev.y) * by) / dt)};
+        }
+
+        // Interpolate between the two samples bracketing t
+        for (uint32_t age = 1; age < m_count; ++age) {
+            const Sample& older = at(age);
+            const Sample& newer = at(age - 1);
+            if (static_cast<int32_t>(t - older.time) >= 0) {
+                const int32_t span = static_cast<int32_t>(newer.time - older.time);
+                if (span <= 0 || span > static_cast<int32_t>(cfg.max_gap_ms)) {
+                    return {newer.x, newer.y};
+                }
+                const int32_t into = static_cast<int32_t>(t - older.time);
+                return {lerp(older.x, newer.x, into, span), lerp(older.y, newer.y, into, span)};
+            }
+        }
+        // t older than the history: oldest known point
+        const Sample& oldest = at(m_count - 1);
+        return {oldest.x, oldest.y};
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Interpolating/predicting stage for pointer indevs
+ *
+ * Non-movable (registered as an indev tap and display event callback with
+ * `this` as context).
+ *
+ * @tparam History Number of raw samples kept (power of two)
+ */
+template<size_t History = 8>
+class BasicTouchResampler {
+    using TimeFn = uint32_t (*)(const void* ctx);
+
+    lv_indev_t* m_indev = nullptr;
+    lv_display_t* m_display = nullptr;
+    ResampleConfig m_cfg;
+    detail::TouchHistory<History> m_history;
+    TimeFn m_time_fn = nullptr;     ///< Sample time source (nullptr = read time)
+    const void* m_time_ctx = nullptr;
+    bool m_pressed = false;
+
+    static void tap(lv_indev_t*, lv_indev_data_t* data, void* ctx) {
+        static_cast<BasicTouchResampler*>(ctx)->process(data);
+    }
+
+    void process(lv_indev_data_t* data) noexcept {
+        const bool pressed = data->state == LV_INDEV_STATE_PRESSED;
+        if (!pressed) {
+            // Release: report the real lift-off point, forget the stroke
+            m_pressed = false;
+            m_history.clear();
+            return;
+        }
+        const uint32_t now = lv_tick_get();
+        m_history.add(m_time_fn ? m_time_fn(m_time_ctx) : now, data->point);
+        if (!m_pressed) {
+            // Press: report the real touch-down point
+            m_pressed = true;
+            return;
+        }
+        data->point = m_history.resample(now, m_cfg);
+    }
+
+    static void display_event_cb(lv_event_t* e) {
+        auto* self = static_cast<BasicTouchResampler*>(lv_event_get_user_data(e));
+        if (lv_event_get_code(e) == LV_EVENT_DELETE) {
+            self->m_display = nullptr;
+            return;
+        }
+        // LV_EVENT_REFR_START: move to the position at render time before layout and drawing
+        if (self->m_pressed && self->m_indev) lv_indev_read(self->m_indev);
+    }
+
+public:
+    /// Attach to a pointer indev
+    explicit BasicTouchResampler(lv_indev_t* indev, ResampleConfig cfg = {}) noexcept
+        : m_cfg(cfg) {
+        attach(indev);
+    }
+
+    /// Attach to an EventIndev, using its sample time stamps
+    template<size_t N>
+    explicit BasicTouchResampler(BasicEventIndev<N>& indev, ResampleConfig cfg = {}) noexcept
+        : m_cfg(cfg) {
+        attach(indev);
+    }
+
+    ~BasicTouchResampler() { detach(); }
+
+    BasicTouchResampler(const BasicTouchResampler&) = delete;
+    BasicTouchResampler& operator=(const BasicTouchResampler&) = delete;
+
+    /// Attach to an indev (detaches from the previous one)
+    bool attach(lv_indev_t* indev) noexcept {
+        detach();
+        if (!indev || !indev_add_tap(indev, &tap, this)) return false;
+        m_indev = indev;
+        m_display = lv_indev_get_display(indev);
+        if (!m_display) m_display = lv_display_get_default();
+        if (m_display) {
+            lv_display_add_event_cb(m_display, &display_event_cb, LV_EVENT_REFR_START, this);
+            lv_display_add_event_cb(m_display, &display_event_cb, LV_EVENT_DELETE, this);
+        }
+        return true;
+    }
+
+    /// Attach to an EventIndev, using its sample time stamps
+    template<size_t N>
+    bool attach(BasicEventIndev<N>& indev) noexcept {
+        if (!attach(indev.get())) return false;
+        m_time_fn = [](const void* ctx) { return static_cast<const BasicEventIndev<N>*>(ctx)->sample_time(); };
+        m_time_ctx = &indev;
+        return true;
+    }
+
+    /// Stop resampling; the indev reports raw points again
+    void detach() noexcept {
+        if (m_indev) {
+            indev_remove_tap(m_indev, &tap, this);
+            m_indev = nullptr;
+        }
+        if (m_display) {
+            lv_display_remove_event_cb_with_user_data(m_display, &display_event_cb, this);
+            m_display = nullptr;
+        }
+        m_time_fn = nullptr;
+        m_time_ctx = nullptr;
+        m_history.clear();
+        m_pressed = false;
+    }
+
+    /// Replace the configuration
+    BasicTouchResampler& config(const ResampleConfig& cfg) noexcept {
+        m_cfg = cfg;
+        return *this;
+    }
+
+    /// Get the configuration
+    [[nodiscard]] const ResampleConfig& config() const noexcept { return m_cfg; }
+
+    /// Set prediction horizon
+    BasicTouchResampler& predict(uint32_t ms) noexcept {
+        m_cfg.predict_ms = ms;
+        return *this;
+    }
+
+    /**
+     * @brief Poll the indev at the display refresh period
+     *
+     * Reading once per frame (instead of at an unrelated period) removes
+     * the beat between input and render rate. No-op in event mode.
+     */
+    BasicTouchResampler& sync_period(uint32_t period_ms = LV_DEF_REFR_PERIOD) noexcept {
+        if (m_indev) {
+            if (lv_timer_t* t = lv_indev_get_read_timer(m_indev)) {
+                lv_timer_set_period(t, period_ms);
+            }
+        }
+        return *this;
+    }
+};
+
+/// Touch resampler with an 8-sample history
+using TouchResampler = BasicTouchResampler<8>;
+
+} // namespace lv
@@ -0,0 +1,452 @@
+#pragma once
+
+/**
+ * @file drm_display.hpp
+ * @brief Linux DRM/KMS backend: zero-copy rendering into page-flipped dumb buffers
+ *
+ * DRMDisplay sets up the device itself instead of going through
+ * lv_linux_drm_create():
+ *
+ * - Two dumb buffers are created and mapped; LVGL renders straight into
+ *   them in direct mode (no intermediate draw buffer, no full-frame copy).
+ *   LVGL copies only the dirty areas of the last frame into the back buffer.
+ * - The last area of a frame queues a page flip (an atomic commit of the
+ *   primary plane's FB_ID, or drmModePageFlip() without atomic support)
+ *   with a page-flip event. The event completes the flush, so frames are
+ *   paced by vblank and never torn.
+ * - The DRM fd becomes readable when the flip completes: wait() sleeps on
+ *   it in the main loop, or fd()/dispatch() integrate it in an existing
+ *   poll() loop. If the next frame starts before the event was handled,
+ *   LVGL blocks on the fd instead.
+ *
+ * @code
+ * lv::init();
+ * lv::DRMDisplay display;                           // /dev/dri/card0, first connected output
+ * lv::DRMDisplay display({.device = "/dev/dri/card1", .connector_id = 42});
+ * // ... create UI ...
+ * while (true) {
+ *     display.wait(lv_timer_handler());             // Wakes on page flips
+ * }
+ * @endcode
+ *
+ * Needs DRM master (no other compositor running) and libdrm.
+ */
+
+#include <lvgl.h>
+#include "../core/display.hpp"
+
+#if LV_USE_LINUX_DRM
+#include <src/display/lv_display_private.h>   // inv_p
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+#include <drm_fourcc.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+namespace lv {
+
+/// DRMDisplay options
+struct DRMConfig {
+    const char* device = "/dev/dri/card0";   ///< DRM device node
+    uint32_t connector_id = 0;               ///< Connector to use (0 = first connected one)
+    bool atomic = true;                      ///< Flip with atomic commits when the driver supports them
+};
+
+/**
+ * @brief DRM/KMS display with direct rendering into scanout buffers
+ *
+ * Owns its lv_display_t and the DRM device. Non-copyable and non-movable
+ * (the display's driver_data and pending page flips point to this).
+ * On failure the display is not created: check valid().
+ */
+class DRMDisplay : public Display {
+public:
+    /// Scanout buffers (front and back)
+    static constexpr uint32_t BUFFERS = 2;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Buffer {
+        uint32_t handle = 0;
+        uint32_t pitch = 0;
+        uint32_t fb = 0;
+        uint64_t size = 0;
+        uint8_t* map = nullptr;
+        lv_draw_buf_t draw_buf{};
+    };
+
+    int m_fd = -1;
+    uint32_t m_connector = 0;
+    uint32_t m_crtc = 0;
+    uint32_t m_plane = 0;
+    uint32_t m_fb_prop = 0;          ///< Primary plane's FB_ID property (atomic)
+    drmModeModeInfo m_mode{};
+    drmModeCrtc* m_saved_crtc = nullptr;
+    Buffer m_bufs[BUFFERS];
+
+    bool m_pending = false;          ///< Page flip queued, event not handled yet
+    uint32_t m_flips = 0;
+    uint32_t m_waits = 0;
+    uint64_t m_wait_us = 0;
+
+    // ==================== Device Setup ====================
+
+    [[nodiscard]] static uint32_t prop_id(int fd, uint32_t obj, uint32_t type, const char* name,
+                                          uint64_t* value = nullptr) noexcept {
+        drmModeObjectProperties* props = drmModeObjectGetProperties(fd, obj, type);
+        if (!props) return 0;
+        uint32_t id = 0;
+        for (uint32_t i = 0; i < props->count_props && !id; ++i) {
+            drmModePropertyRes* p = drmModeGetProperty(fd, props->props[i]);
+            if (!p) continue;
+            if (std::strcmp(p->name, name) == 0) {
+                id = p->prop_id;
+                if (value) *value = props->prop_values[i];
+            }
+            drmModeFreeProperty(p);
+        }
+        drmModeFreeObjectProperties(props);
+        return id;
+    }
+
+    /// Pick connector, mode and CRTC; returns the CRTC index or -1
+    int32_t find_output(drmModeRes* res, uint32_t connector_id) noexcept {
+        drmModeConnector* conn = nullptr;
+        for (int i = 0; i < res->count_connectors && !conn; ++i) {
+            drmModeConnector* c = drmModeGetConnector(m_fd, res->connectors[i]);
+            if (!c) continue;
+            if (c->connection == DRM_MODE_CONNECTED && c->count_modes > 0 &&
+                (connector_id == 0 || c->connector_id == connector_id)) {
+                conn = c;
+            } else {
+                drmModeFreeConnector(c);
+            }
+        }
+        if (!conn) return -1;
+
+        m_connector = conn->connector_id;
+        m_mode = conn->modes[0];
+        for (int i = 0; i < conn->count_modes; ++i) {
+            if (conn->modes[i].type & DRM_MODE_TYPE_PREFERRED) {
+                m_mode = conn->modes[i];
+                break;
+            }
+        }
+
+        // Keep the CRTC the connector is driven by, else take any compatible one
+        int32_t index = -1;
+        for (int e = -1; e < conn->count_encoders && index < 0; ++e) {
+            const uint32_t enc_id = e < 0 ? conn->encoder_id : conn->encoders[e];
+            drmModeEncoder* enc = enc_id ? drmModeGetEncoder(m_fd, enc_id) : nullptr;
+            if (!enc) continue;
+            for (int c = 0; c < res->count_crtcs && index < 0; ++c) {
+                const bool match = e < 0 ? res->crtcs[c] == enc->crtc_id
+                                         : (enc->possible_crtcs & (1u << c)) != 0;
+                if (match) index = c;
+            }
+            drmModeFreeEncoder(enc);
+        }
+        drmModeFreeConnector(conn);
+        if (index >= 0) m_crtc = res->crtcs[index];
+        return index;
+    }
+
+    /// Find the CRTC's primary plane and its FB_ID property
+    void find_plane(int32_t crtc_index) noexcept {
+        drmModePlaneRes* planes = drmModeGetPlaneResources(m_fd);
+        if (!planes) return;
+        for (uint32_t i = 0; i < planes->count_planes && !m_plane; ++i) {
+            drmModePlane* plane = drmModeGetPlane(m_fd, planes->planes[i]);
+            if (!plane) continue;
+            uint64_t type = 0;
+            if ((plane->possible_crtcs & (1u << crtc_index)) &&
+                prop_id(m_fd, plane->plane_id, DRM_MODE_OBJECT_PLANE, "type", &type) &&
+                type == DRM_PLANE_TYPE_PRIMARY) {
+                m_plane = plane->plane_id;
+                m_fb_prop = prop_id(m_fd, m_plane, DRM_MODE_OBJECT_PLANE, "FB_ID");
+            }
+            drmModeFreePlane(plane);
+        }
+        drmModeFreePlaneResources(planes);
+    }
+
+    [[nodiscard]] bool create_buffer(Buffer& b) noexcept {
+        drm_mode_create_dumb create{};
+        create.width = m_mode.hdisplay;
+        create.height = m_mode.vdisplay;
+        create.bpp = 32;
+        if (drmIoctl(m_fd, DRM_IOCTL_MODE_CREATE_DUMB, &create) != 0) return false;
+        b.handle = create.handle;
+        b.pitch = create.pitch;
+        b.size = create.size;
+
+        const uint32_t handles[4] = {b.handle};
+        const uint32_t pitches[4] = {b.pitch};
+        const uint32_t offsets[4] = {};
+        if (drmModeAddFB2(m_fd, m_mode.hdisplay, m_mode.vdisplay, DRM_FORMAT_XRGB8888,
+                          handles, pitches, offsets, &b.fb, 0) != 0) {
+            return false;
+        }
+
+        drm_mode_map_dumb map{};
+        map.handle = b.handle;
+        if (drmIoctl(m_fd, DRM_IOCTL_MODE_MAP_DUMB, &map) != 0) return false;
+        void* p = mmap(nullptr, b.size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd,
+                       static_cast<off_t>(map.offset));
+        if (p == MAP_FAILED) return false;
+        b.map = static_cast<uint8_t*>(p);
+        std::memset(b.map, 0, b.size);
+        return true;
+    }
+
+    void destroy_buffer(Buffer& b) noexcept {
+        if (b.map) munmap(b.map, b.size);
+        if (b.fb) drmModeRmFB(m_fd, b.fb);
+        if (b.handle) {
+            drm_mode_destroy_dumb destroy{};
+            destroy.handle = b.handle;
+            drmIoctl(m_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy);
+        }
+        b = Buffer{};
+    }
+
+    [[nodiscard]] bool open_device(const DRMConfig& cfg) noexcept {
+        m_fd = ::open(cfg.device, O_RDWR | O_CLOEXEC);
+        if (m_fd < 0) {
+            LV_LOG_WARN("DRMDisplay: can't open %s", cfg.device);
+            return false;
+        }
+        const bool atomic = cfg.atomic &&
+                            drmSetClientCap(m_fd, DRM_CLIENT_CAP_UNIVERSAL_PLANES, 1) == 0 &&
+                            drmSetClientCap(m_fd, DRM_CLIENT_CAP_ATOMIC, 1) == 0;
+
+        drmModeRes* res = drmModeGetResources(m_fd);
+        if (!res) {
+            LV_LOG_WARN("DRMDisplay: %s is not a KMS device", cfg.device);
+            return false;
+        }
+        const int32_t crtc_index = find_output(res, cfg.connector_id);
+        drmModeFreeResources(res);
+        if (crtc_index < 0) {
+            LV_LOG_WARN("DRMDisplay: no connected output with a usable CRTC");
+            return false;
+        }
+        if (atomic) find_plane(crtc_index);
+
+        for (Buffer& b : m_bufs) {
+            if (!create_buffer(b)) {
+                LV_LOG_WARN("DRMDisplay: can't create a %ux%u dumb buffer",
+                            static_cast<unsigned>(m_mode.hdisplay), static_cast<unsigned>(m_mode.vdisplay));
+                return false;
+            }
+        }
+
+        m_saved_crtc = drmModeGetCrtc(m_fd, m_crtc);
+        if (drmModeSetCrtc(m_fd, m_crtc, m_bufs[0].fb, 0, 0, &m_connector, 1, &m_mode) != 0) {
+            LV_LOG_WARN("DRMDisplay: mode set failed (is another DRM master running?)");
+            return false;
+        }
+        return true;
+    }
+
+    void close_device() noexcept {
+        if (m_fd < 0) return;
+        if (m_saved_crtc) {
+            drmModeSetCrtc(m_fd, m_saved_crtc->crtc_id, m_saved_crtc->buffer_id,
+                           m_saved_crtc->x, m_saved_crtc->y, &m_connector, 1, &m_saved_crtc->mode);
+            drmModeFreeCrtc(m_saved_crtc);
+            m_saved_crtc = nullptr;
+        }
+        for (Buffer& b : m_bufs) destroy_buffer(b);
+        ::close(m_fd);
+        m_fd = -1;
+    }
+
+    // ==================== Flushing ====================
+
+    static void flush_cb(lv_display_t* disp, const lv_area_t*, uint8_t* px_map) {
+        // Direct mode: the areas are already in the buffer, flip once per frame
+        if (!lv_display_flush_is_last(disp)) {
+            lv_display_flush_ready(disp);
+            return;
+        }
+        static_cast<DRMDisplay*>(lv_display_get_driver_data(disp))->flip(px_map);
+    }
+
+    static void flush_wait_cb(lv_display_t* disp) {
+        static_cast<DRMDisplay*>(lv_display_get_driver_data(disp))->wait_flip();
+    }
+
+    static void refr_start_cb(lv_event_t* e) {
+        // Don't touch the back buffer while it is still being scanned out
+        auto* self = static_cast<DRMDisplay*>(lv_event_get_user_data(e));
+        if (self->m_pending && self->get()->inv_p > 0) self->wait_flip();
+    }
+
+    static void page_flip_handler(int, unsigned, unsigned, unsigned, void* user_data) {
+        auto* self = static_cast<DRMDisplay*>(user_data);
+        self->m_pending = false;
+        ++self->m_flips;
+        lv_display_flush_ready(self->get());
+    }
+
+    void flip(uint8_t* px_map) noexcept {
+        const Buffer* b = nullptr;
+        for (const Buffer& buf : m_bufs) {
+            if (buf.map == px_map) b = &buf;
+        }
+        int r = -1;
+        if (b && m_fb_prop) {
+            drmModeAtomicReq* req = drmModeAtomicAlloc();
+            if (req) {
+                drmModeAtomicAddProperty(req, m_plane, m_fb_prop, b->fb);
+                r = drmModeAtomicCommit(m_fd, req, DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT, this);
+                drmModeAtomicFree(req);
+            }
+        } else if (b) {
+            r = drmModePageFlip(m_fd, m_crtc, b->fb, DRM_MODE_PAGE_FLIP_EVENT, this);
+        }
+        if (r != 0) {
+            LV_LOG_WARN("DRMDisplay: page flip failed");
+            lv_display_flush_ready(get());
+            return;
+        }
+        m_pending = true;
+    }
+
+    /// Block until the queued page flip completed
+    void wait_flip() noexcept {
+        if (!m_pending) return;
+        const Clock::time_point t0 = Clock::now();
+        while (m_pending) {
+            pollfd pfd{m_fd, POLLIN, 0};
+            if (::poll(&pfd, 1, 1000) <= 0) {
+                LV_LOG_WARN("DRMDisplay: no page-flip event");
+                m_pending = false;
+                lv_display_flush_ready(get());
+                break;
+            }
+            handle_event();
+        }
+        ++m_waits;
+        m_wait_us += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count());
+    }
+
+    void handle_event() noexcept {
+        drmEventContext ctx{};
+        ctx.version = 2;
+        ctx.page_flip_handler = &page_flip_handler;
+        drmHandleEvent(m_fd, &ctx);
+    }
+
+public:
+    /**
+     * @brief Open the device, set the mode and create the display
+     *
+     * @param cfg Device, connector and flip options
+     */
+    explicit DRMDisplay(const DRMConfig& cfg = {}) noexcept
+        : Display(nullptr) {
+        if (!open_device(cfg)) {
+            close_device();
+            return;
+        }
+
+        lv_display_t* disp = lv_display_create(m_mode.hdisplay, m_mode.vdisplay);
+        if (!disp) {
+            close_device();
+            return;
+        }
+        lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);
+        for (Buffer& b : m_bufs) {
+            lv_draw_buf_init(&b.draw_buf, m_mode.hdisplay, m_mode.vdisplay, LV_COLOR_FORMAT_XRGB8888,
+                             b.pitch, b.map, static_cast<uint32_t>(b.size));
+        }
+        // Buffer 0 is on screen after the mode set: render into buffer 1 first
+        lv_display_set_draw_buffers(disp, &m_bufs[1].draw_buf, &m_bufs[0].draw_buf);
+        lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+        lv_display_set_driver_data(disp, this);
+        lv_display_set_flush_cb(disp, &flush_cb);
+        lv_display_set_flush_wait_cb(disp, &flush_wait_cb);
+        lv_display_add_event_cb(disp, &refr_start_cb, LV_EVENT_REFR_START, this);
+        set_display(disp);
+    }
+
+    /// Delete the display and restore the previous mode
+    ~DRMDisplay() {
+        if (valid()) {
+            wait_flip();
+            lv_display_delete(get());
+            set_display(nullptr);
+        }
+        close_device();
+    }
+
+    DRMDisplay(const DRMDisplay&) = delete;
+    DRMDisplay& operator=(const DRMDisplay&) = delete;
+
+    /// DRM fd, readable when a page-flip event is pending (-1 if not open)
+    [[nodiscard]] int fd() const noexcept { return m_fd; }
+
+    /// Connector in use
+    [[nodiscard]] uint32_t connector_id() const noexcept { return m_connector; }
+
+    /// Refresh rate of the mode in Hz
+    [[nodiscard]] uint32_t refresh_rate() const noexcept { return m_mode.vrefresh; }
+
+    /// Check if flips use atomic commits
+    [[nodiscard]] bool atomic() const noexcept { return m_fb_prop != 0; }
+
+    /**
+     * @brief Handle a pending page-flip event without blocking
+     *
+     * @return true if an event was handled
+     */
+    bool dispatch() noexcept {
+        if (m_fd < 0) return false;
+        pollfd pfd{m_fd, POLLIN, 0};
+        if (::poll(&pfd, 1, 0) <= 0) return false;
+        handle_event();
+        return true;
+    }
+
+    /**
+     * @brief Sleep until a page flip completes or timeout expires
+     *
+     * Drop-in replacement for lv::sleep_ms() in the main loop: pass the
+     * value returned by lv_timer_handler().
+     *
+     * @return true if a page-flip event was handled
+     */
+    bool wait(uint32_t timeout_ms) noexcept {
+        if (m_fd < 0) {
+            lv_delay_ms(timeout_ms);
+            return false;
+        }
+        pollfd pfd{m_fd, POLLIN, 0};
+        const int timeout = timeout_ms == LV_NO_TIMER_READY ? -1 : static_cast<int>(timeout_ms);
+        if (::poll(&pfd, 1, timeout) <= 0) return false;
+        handle_event();
+        return true;
+    }
+
+    /// Completed page flips
+    [[nodiscard]] uint32_t flips() const noexcept { return m_flips; }
+
+    /// Times rendering had to wait for a page flip
+    [[nodiscard]] uint32_t flip_waits() const noexcept { return m_waits; }
+
+    /// Total time rendering waited for page flips
+    [[nodiscard]] uint64_t flip_wait_us() const noexcept { return m_wait_us; }
+};
+
+} // namespace lv
+
+#endif // LV_USE_LINUX_DRM
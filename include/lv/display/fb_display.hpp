@@ -0,0 +1,414 @@
+#pragma once
+
+/**
+ * @file fb_display.hpp
+ * @brief Linux framebuffer backend: pan double buffering and dirty-area copy
+ *
+ * FBDisplay drives /dev/fbN itself instead of going through
+ * lv_linux_fbdev_create():
+ *
+ * | Render mode | Framebuffer | Pixels reach the screen by |
+ * |-------------|-------------|----------------------------|
+ * | partial | any | Copying each rendered area (1 or 2 chunk buffers) |
+ * | direct / full | `yres_virtual >= 2 * yres` | Rendering into the hidden page, then FBIOPAN_DISPLAY (no copy) |
+ * | direct / full | single page | Copying the dirty areas of a full-screen buffer |
+ *
+ * The virtual height is raised to two pages when video memory allows.
+ * Rows are copied with SSE2 streaming stores or NEON (memcpy elsewhere),
+ * which suits uncached/write-combined framebuffer memory.
+ *
+ * @code
+ * lv::FBDisplay display;                                      // /dev/fb0, partial, 2 buffers
+ * lv::FBDisplay display({.render_mode = LV_DISPLAY_RENDER_MODE_DIRECT});  // Pan if possible
+ * // ...
+ * display.log();   // Copy bandwidth per frame
+ * @endcode
+ *
+ * In copy modes the copy can run on a flush thread with lv::AsyncFlush;
+ * frame statistics are then counted when LVGL finishes the refresh.
+ */
+
+#include <lvgl.h>
+#include "../core/display.hpp"
+
+/// Build FBDisplay (Linux only; CMake defines it with LV_WITH_FBDISPLAY)
+#ifndef LV_CPP_USE_FBDISPLAY
+#define LV_CPP_USE_FBDISPLAY 0
+#endif
+
+#if LV_CPP_USE_FBDISPLAY
+#include <src/display/lv_display_private.h>   // render_mode
+#include <linux/fb.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace lv {
+
+/// FBDisplay options
+struct FBConfig {
+    const char* device = "/dev/fb0";   ///< Framebuffer device node
+    lv_display_render_mode_t render_mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+    uint8_t buffers = 2;               ///< Draw buffers (1 or 2)
+    uint32_t buf_size = 0;             ///< Partial mode: bytes per buffer (0 = 1/10 screen)
+    bool pan = true;                   ///< Direct/full with 2 buffers: render into framebuffer pages
+    bool vsync = true;                 ///< Wait for vblank after panning (FBIO_WAITFORVSYNC)
+};
+
+/// Framebuffer copy statistics
+struct FBStats {
+    uint32_t frames = 0;         ///< Frames flushed
+    uint64_t bytes = 0;          ///< Bytes copied to the framebuffer
+    uint64_t copy_us = 0;        ///< Time spent copying
+    uint32_t last_bytes = 0;     ///< Bytes copied for the last frame
+    uint32_t last_copy_us = 0;   ///< Copy time of the last frame
+
+    /// Average bytes copied per frame
+    [[nodiscard]] uint32_t bytes_per_frame() const noexcept {
+        return frames ? static_cast<uint32_t>(bytes / frames) : 0;
+    }
+
+    /// Copy bandwidth in MB/s (bytes per µs)
+    [[nodiscard]] uint32_t mb_per_s() const noexcept {
+        return copy_us ? static_cast<uint32_t>(bytes / copy_us) : 0;
+    }
+};
+
+namespace detail {
+
+/// Copy n bytes into framebuffer memory, bypassing the cache where possible
+inline void fb_copy_row(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+#if defined(__SSE2__)
+    const uint32_t head = static_cast<uint32_t>(-reinterpret_cast<uintptr_t>(dst) & 15);
+    if (head >= n) {
+        std::memcpy(dst, src, n);
+        return;
+    }
+    std::memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    n -= head;
+    for (; n >= 64; n -= 64, dst += 64, src += 64) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst), a);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 48), d);
+    }
+    for (; n >= 16; n -= 16, dst += 16, src += 16) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    }
+#elif defined(__ARM_NEON)
+    for (; n >= 64; n -= 64, dst += 64, src += 64) {
+        const uint8x16_t a = vld1q_u8(src);
+        const uint8x16_t b = vld1q_u8(src + 16);
+        const uint8x16_t c = vld1q_u8(src + 32);
+        const uint8x16_t d = vld1q_u8(src + 48);
+        vst1q_u8(dst, a);
+        vst1q_u8(dst + 16, b);
+        vst1q_u8(dst + 32, c);
+        vst1q_u8(dst + 48, d);
+    }
+    for (; n >= 16; n -= 16, dst += 16, src += 16) {
+        vst1q_u8(dst, vld1q_u8(src));
+    }
+#endif
+    if (n) std::memcpy(dst, src, n);
+}
+
+/// Order streaming stores before the frame is reported done
+inline void fb_copy_fence() noexcept {
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Linux framebuffer display
+ *
+ * Owns its lv_display_t and the device. Non-copyable and non-movable (the
+ * display's driver_data points to this). On failure the display is not
+ * created: check valid().
+ */
+class FBDisplay : public Display {
+    using Clock = std::chrono::steady_clock;
+
+    int m_fd = -1;
+    fb_var_screeninfo m_var{};
+    fb_var_screeninfo m_saved_var{};
+    fb_fix_screeninfo m_fix{};
+    uint8_t* m_fb = nullptr;
+    uint32_t m_px_size = 0;          ///< Bytes per pixel
+    lv_color_format_t m_cf = LV_COLOR_FORMAT_XRGB8888;
+
+    bool m_pan = false;              ///< Render into framebuffer pages
+    bool m_vsync = false;
+    uint8_t* m_pages[2] = {};
+    lv_draw_buf_t m_page_bufs[2]{};
+    void* m_bufs[2] = {};            ///< Unaligned RAM buffers (copy modes)
+
+    FBStats m_stats;
+    // Copy mode: added by flush_cb, which may run on an AsyncFlush thread
+    std::atomic<uint32_t> m_frame_bytes{0};
+    std::atomic<uint64_t> m_frame_us{0};
+
+    [[nodiscard]] bool open_device(const FBConfig& cfg) noexcept {
+        m_fd = ::open(cfg.device, O_RDWR | O_CLOEXEC);
+        if (m_fd < 0) {
+            LV_LOG_WARN("FBDisplay: can't open %s", cfg.device);
+            return false;
+        }
+        if (ioctl(m_fd, FBIOGET_VSCREENINFO, &m_var) != 0 ||
+            ioctl(m_fd, FBIOGET_FSCREENINFO, &m_fix) != 0) {
+            LV_LOG_WARN("FBDisplay: %s is not a framebuffer", cfg.device);
+            return false;
+        }
+        m_saved_var = m_var;
+
+        switch (m_var.bits_per_pixel) {
+        case 32: m_cf = LV_COLOR_FORMAT_XRGB8888; break;
+        case 24: m_cf = LV_COLOR_FORMAT_RGB888; break;
+        case 16: m_cf = LV_COLOR_FORMAT_RGB565; break;
+        default:
+            LV_LOG_WARN("FBDisplay: %u bpp is not supported", static_cast<unsigned>(m_var.bits_per_pixel));
+            return false;
+        }
+        m_px_size = m_var.bits_per_pixel / 8;
+
+        const uint64_t page = static_cast<uint64_t>(m_fix.line_length) * m_var.yres;
+        if (cfg.pan && cfg.buffers >= 2 && cfg.render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL &&
+            m_fix.ypanstep != 0 && m_fix.smem_len >= 2 * page) {
+            if (m_var.yres_virtual < 2 * m_var.yres) {
+                fb_var_screeninfo var = m_var;
+                var.yres_virtual = 2 * m_var.yres;
+                if (ioctl(m_fd, FBIOPUT_VSCREENINFO, &var) == 0) {
+                    ioctl(m_fd, FBIOGET_VSCREENINFO, &m_var);
+                    ioctl(m_fd, FBIOGET_FSCREENINFO, &m_fix);
+                }
+            }
+            m_pan = m_var.yres_virtual >= 2 * m_var.yres &&
+                    m_fix.smem_len >= 2 * static_cast<uint64_t>(m_fix.line_length) * m_var.yres;
+        }
+
+        void* p = mmap(nullptr, m_fix.smem_len, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (p == MAP_FAILED) {
+            LV_LOG_WARN("FBDisplay: can't map %s", cfg.device);
+            return false;
+        }
+        m_fb = static_cast<uint8_t*>(p);
+        return true;
+    }
+
+    void close_device() noexcept {
+        for (void*& b : m_bufs) {
+            lv_free(b);
+            b = nullptr;
+        }
+        if (m_fb) {
+            munmap(m_fb, m_fix.smem_len);
+            m_fb = nullptr;
+        }
+        if (m_fd >= 0) {
+            if (m_saved_var.yres_virtual != m_var.yres_virtual || m_var.yoffset != m_saved_var.yoffset) {
+                ioctl(m_fd, FBIOPUT_VSCREENINFO, &m_saved_var);
+            }
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    /// Zero-copy: LVGL renders into the hidden page, page 0 is shown first
+    void setup_pages(lv_display_t* disp, lv_display_render_mode_t mode) noexcept {
+        const uint32_t page = m_fix.line_length * m_var.yres;
+        for (uint32_t i = 0; i < 2; ++i) {
+            m_pages[i] = m_fb + i * page + m_var.xoffset * m_px_size;
+            lv_draw_buf_init(&m_page_bufs[i], m_var.xres, m_var.yres, m_cf, m_fix.line_length,
+                             m_pages[i], page);
+        }
+        m_var.yoffset = 0;
+        ioctl(m_fd, FBIOPAN_DISPLAY, &m_var);
+        lv_display_set_draw_buffers(disp, &m_page_bufs[1], &m_page_bufs[0]);
+        lv_display_set_render_mode(disp, mode);
+    }
+
+    [[nodiscard]] bool setup_buffers(lv_display_t* disp, const FBConfig& cfg) noexcept {
+        const uint32_t stride = lv_draw_buf_width_to_stride(m_var.xres, m_cf);
+        uint32_t size = cfg.buf_size;
+        if (cfg.render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) {
+            size = stride * m_var.yres;
+        } else if (size == 0) {
+            size = stride * LV_MAX(m_var.yres / 10, 1u);
+        }
+        const uint32_t count = cfg.buffers >= 2 ? 2 : 1;
+        void* aligned[2] = {};
+        for (uint32_t i = 0; i < count; ++i) {
+            m_bufs[i] = lv_malloc(size + LV_DRAW_BUF_ALIGN - 1);
+            if (!m_bufs[i]) {
+                LV_LOG_WARN("FBDisplay: out of memory for draw buffers");
+                return false;
+            }
+            aligned[i] = lv_draw_buf_align(m_bufs[i], m_cf);
+        }
+        lv_display_set_buffers(disp, aligned[0], aligned[1], size, cfg.render_mode);
+        return true;
+    }
+
+    static void flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
+        auto* self = static_cast<FBDisplay*>(lv_display_get_driver_data(disp));
+        if (self->m_pan) {
+            if (lv_display_flush_is_last(disp)) {
+                self->pan_to(px_map);
+                self->end_frame();
+            }
+        } else {
+            // No LVGL state read here: this may run on an AsyncFlush thread
+            self->copy_area(*area, px_map, disp->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL);
+        }
+        lv_display_flush_ready(disp);
+    }
+
+    /// Copy mode: close the frame's statistics once LVGL is done with it
+    static void refr_ready_cb(lv_event_t* e) {
+        auto* self = static_cast<FBDisplay*>(lv_event_get_user_data(e));
+        if (self->m_frame_bytes.load(std::memory_order_relaxed)) self->end_frame();
+    }
+
+    void copy_area(const lv_area_t& area, const uint8_t* px_map, bool partial) noexcept {
+        const Clock::time_point t0 = Clock::now();
+        const uint32_t w = static_cast<uint32_t>(lv_area_get_width(&area));
+        const uint32_t h = static_cast<uint32_t>(lv_area_get_height(&area));
+        const uint32_t row = w * m_px_size;
+
+        // Partial: px_map holds just the area; direct/full: the whole screen
+        const uint32_t src_stride = lv_draw_buf_width_to_stride(partial ? w : m_var.xres, m_cf);
+        const uint8_t* src = partial ? px_map
+                                     : px_map + area.y1 * src_stride + area.x1 * m_px_size;
+        uint8_t* dst = m_fb + (area.y1 + m_var.yoffset) * m_fix.line_length +
+                       (area.x1 + m_var.xoffset) * m_px_size;
+
+        for (uint32_t y = 0; y < h; ++y) {
+            detail::fb_copy_row(dst, src, row);
+            dst += m_fix.line_length;
+            src += src_stride;
+        }
+        detail::fb_copy_fence();
+
+        m_frame_bytes.fetch_add(row * h, std::memory_order_relaxed);
+        m_frame_us.fetch_add(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count()),
+            std::memory_order_relaxed);
+    }
+
+    void pan_to(const uint8_t* px_map) noexcept {
+        m_var.yoffset = px_map == m_pages[1] ? m_var.yres : 0;
+        if (ioctl(m_fd, FBIOPAN_DISPLAY, &m_var) != 0) {
+            LV_LOG_WARN("FBDisplay: FBIOPAN_DISPLAY failed");
+            return;
+        }
+        uint32_t screen = 0;
+        if (m_vsync && ioctl(m_fd, FBIO_WAITFORVSYNC, &screen) != 0) {
+            LV_LOG_WARN("FBDisplay: FBIO_WAITFORVSYNC not supported, panning without vsync");
+            m_vsync = false;
+        }
+    }
+
+    void end_frame() noexcept {
+        const uint32_t bytes = m_frame_bytes.exchange(0, std::memory_order_relaxed);
+        const uint64_t us = m_frame_us.exchange(0, std::memory_order_relaxed);
+        ++m_stats.frames;
+        m_stats.bytes += bytes;
+        m_stats.copy_us += us;
+        m_stats.last_bytes = bytes;
+        m_stats.last_copy_us = static_cast<uint32_t>(us);
+    }
+
+public:
+    /**
+     * @brief Open the framebuffer and create the display
+     *
+     * @param cfg Device, render mode and buffering options
+     */
+    explicit FBDisplay(const FBConfig& cfg = {}) noexcept
+        : Display(nullptr) {
+        if (!open_device(cfg)) {
+            close_device();
+            return;
+        }
+        lv_display_t* disp = lv_display_create(m_var.xres, m_var.yres);
+        if (!disp) {
+            close_device();
+            return;
+        }
+        lv_display_set_color_format(disp, m_cf);
+        if (m_pan) {
+            setup_pages(disp, cfg.render_mode);
+            m_vsync = cfg.vsync;
+        } else if (!setup_buffers(disp, cfg)) {
+            lv_display_delete(disp);
+            close_device();
+            return;
+        }
+        lv_display_set_driver_data(disp, this);
+        lv_display_set_flush_cb(disp, &flush_cb);
+        if (!m_pan) lv_display_add_event_cb(disp, &refr_ready_cb, LV_EVENT_REFR_READY, this);
+        set_display(disp);
+    }
+
+    /// Delete the display and restore the framebuffer's virtual size
+    ~FBDisplay() {
+        if (valid()) {
+            lv_display_delete(get());
+            set_display(nullptr);
+        }
+        close_device();
+    }
+
+    FBDisplay(const FBDisplay&) = delete;
+    FBDisplay& operator=(const FBDisplay&) = delete;
+
+    /// Check if LVGL renders into framebuffer pages (no copy)
+    [[nodiscard]] bool panning() const noexcept { return m_pan; }
+
+    /// Bits per pixel of the framebuffer
+    [[nodiscard]] uint32_t bpp() const noexcept { return m_var.bits_per_pixel; }
+
+    /// Copy statistics
+    [[nodiscard]] const FBStats& stats() const noexcept { return m_stats; }
+
+    /// Clear copy statistics
+    FBDisplay& reset_stats() noexcept {
+        m_stats = FBStats{};
+        return *this;
+    }
+
+    /// Print copy statistics with LV_LOG_USER
+    void log() const noexcept {
+        LV_LOG_USER("FBDisplay: %s frames=%u copy/frame=%uKB last=%uKB in %uus bandwidth=%uMB/s",
+                    m_pan ? "pan" : "copy", static_cast<unsigned>(m_stats.frames),
+                    static_cast<unsigned>(m_stats.bytes_per_frame() / 1024),
+                    static_cast<unsigned>(m_stats.last_bytes / 1024),
+                    static_cast<unsigned>(m_stats.last_copy_us),
+                    static_cast<unsigned>(m_stats.mb_per_s()));
+    }
+};
+
+} // namespace lv
+
+#endif // LV_CPP_USE_FBDISPLAY
@@ -77,6 +77,6 @@
 #include "image_decoder.hpp" // ImageDecoderDsc, ImageDecoder
 
 // Vector graphics (requires LV_USE_VECTOR_GRAPHIC)
-#include "draw_vector.hpp"   // VectorPath, VectorDsc
+#include "draw_vector.hpp"   // VectorPath, VectorDsc, FrozenPath, VectorScene
 
 // Note: lv_draw_mask_rect_dsc_t is internal to LVGL (private header)
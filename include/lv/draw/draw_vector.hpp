@@ -25,6 +25,12 @@
  *    .add_path(path)
  *    .draw();
  * @endcode
+ *
+ * Static geometry drawn every frame (icons, gauge faces, needles) can be
+ * frozen: `path.freeze()` returns a FrozenPath whose rasterized coverage is
+ * cached per transform and redrawn as an image blit. Drawings whose parts
+ * change independently can be kept in a VectorScene, which redraws only the
+ * areas of the nodes that changed.
  */
 
 #include <lvgl.h>
@@ -32,6 +38,10 @@
 #if LV_USE_VECTOR_GRAPHIC
 
 #include <src/draw/lv_draw_vector.h>
+#include <src/draw/lv_draw_vector_private.h>   // Path ops and points for FrozenPath::hash()
+#include <cstdint>
+#include <cstring>
+#include <utility>
 
 namespace lv {
 
@@ -39,6 +49,8 @@ namespace lv {
 
 class VectorPath;
 class VectorDsc;
+class FrozenPath;
+class VectorScene;
 
 // ==================== Helper Types ====================
 
@@ -68,6 +80,9 @@ using FPoint = lv_fpoint_t;
  * @endcode
  */
 class VectorPath {
+    friend class FrozenPath;
+    friend class VectorScene;
+
     lv_vector_path_t* m_path = nullptr;
 
 public:
@@ -239,6 +254,9 @@ public:
     void transform(const lv_matrix_t& matrix) noexcept {
         lv_matrix_transform_path(&matrix, m_path);
     }
+
+    /// Move the path into an immutable FrozenPath (this path is left empty)
+    [[nodiscard]] FrozenPath freeze() noexcept;
 };
 
 // ==================== VectorDsc ====================
@@ -536,6 +554,833 @@ public:
     }
 };
 
+// ==================== FrozenPath ====================
+
+/// Mask cache statistics, shared by all frozen paths
+struct PathCacheStats {
+    uint32_t hits = 0;         ///< Draws blitted from a cached mask
+    uint32_t misses = 0;       ///< Draws rendered as vectors while a mask is queued
+    uint32_t uncached = 0;     ///< Draws too large to cache
+    uint32_t rasterized = 0;   ///< Masks rendered
+    uint32_t evicted = 0;      ///< Masks dropped for newer ones
+    uint32_t bytes = 0;        ///< Mask memory in use
+};
+
+namespace detail {
+
+/// Coverage mask of one path at one transform
+struct PathMask {
+    enum State : uint8_t { EMPTY, PENDING, READY, FAILED };
+
+    uint64_t hash;
+    float linear[4];                 ///< Matrix without translation
+    int8_t frac_x, frac_y;           ///< Sub-pixel translation in 1/4 px
+    uint8_t quality;
+    State state;
+    float stroke;                    ///< Stroke width, 0 = fill
+    lv_area_t box;                   ///< Mask area relative to the integer translation
+    const lv_vector_path_t* src;     ///< Path to render while PENDING
+    lv_draw_buf_t* buf;              ///< ARGB8888, white with coverage as alpha
+    uint32_t used;                   ///< LRU clock
+};
+
+inline constexpr uint32_t PATH_MASK_SLOTS = 32;
+inline PathMask g_path_masks[PATH_MASK_SLOTS] = {};
+inline uint32_t g_path_mask_clock = 0;
+inline uint32_t g_path_mask_budget = 256 * 1024;
+inline bool g_path_mask_scheduled = false;
+inline PathCacheStats g_path_cache_stats;
+
+/// Hash of a path's commands and points
+[[nodiscard]] inline uint64_t path_hash(const lv_vector_path_t* path) noexcept {
+    uint64_t h = 0xCBF29CE484222325ull;
+    auto mix = [&h](const lv_array_t& a, uint32_t elem) {
+        const uint32_t n = lv_array_size(&a);
+        const auto* p = n ? static_cast<const uint8_t*>(lv_array_at(&a, 0)) : nullptr;
+        for (uint32_t i = 0; i < n * elem; ++i) h = (h ^ p[i]) * 0x100000001B3ull;
+        h = (h ^ n) * 0x100000001B3ull;
+    };
+    mix(path->ops, sizeof(lv_vector_path_op_t));
+    mix(path->points, sizeof(lv_fpoint_t));
+    return h;
+}
+
+/// Bounds of a transformed path, padded for round strokes and anti-aliasing
+[[nodiscard]] inline lv_area_t path_box(const lv_vector_path_t* path, const lv_matrix_t& m, float stroke) noexcept {
+    lv_area_t bb{};
+    lv_vector_path_get_bounding(path, &bb);
+    FPoint corners[4] = {{static_cast<float>(bb.x1), static_cast<float>(bb.y1)},
+                         {static_cast<float>(bb.x2), static_cast<float>(bb.y1)},
+                         {static_cast<float>(bb.x1), static_cast<float>(bb.y2)},
+                         {static_cast<float>(bb.x2), static_cast<float>(bb.y2)}};
+    float x1 = 1e9f, y1 = 1e9f, x2 = -1e9f, y2 = -1e9f;
+    for (FPoint& c : corners) {
+        lv_matrix_transform_point(&m, &c);
+        x1 = c.x < x1 ? c.x : x1;
+        y1 = c.y < y1 ? c.y : y1;
+        x2 = c.x > x2 ? c.x : x2;
+        y2 = c.y > y2 ? c.y : y2;
+    }
+    auto mag = [](float v) { return v < 0 ? -v : v; };
+    const float sx = mag(m.m[0][0]) + mag(m.m[0][1]);
+    const float sy = mag(m.m[1][0]) + mag(m.m[1][1]);
+    const float pad = stroke * (sx > sy ? sx : sy) / 2.0f + 2.0f;
+    auto floor_i = [](float v) { return static_cast<int32_t>(v >= 0 ? v : v - 1); };
+    return {floor_i(x1 - pad), floor_i(y1 - pad), floor_i(x2 + pad) + 1, floor_i(y2 + pad) + 1};
+}
+
+/// Fill (stroke == 0) or stroke a path with round joins and caps
+inline void path_paint(lv_layer_t* layer, const lv_vector_path_t* path, const lv_matrix_t& m,
+                       lv_color_t color, lv_opa_t opa, float stroke) noexcept {
+    lv_draw_vector_dsc_t* dsc = lv_draw_vector_dsc_create(layer);
+    if (!dsc) return;
+    lv_draw_vector_dsc_set_transform(dsc, &m);
+    if (stroke > 0) {
+        lv_draw_vector_dsc_set_fill_opa(dsc, LV_OPA_TRANSP);
+        lv_draw_vector_dsc_set_stroke_color(dsc, color);
+        lv_draw_vector_dsc_set_stroke_opa(dsc, opa);
+        lv_draw_vector_dsc_set_stroke_width(dsc, stroke);
+        lv_draw_vector_dsc_set_stroke_cap(dsc, LV_VECTOR_STROKE_CAP_ROUND);
+        lv_draw_vector_dsc_set_stroke_join(dsc, LV_VECTOR_STROKE_JOIN_ROUND);
+    } else {
+        lv_draw_vector_dsc_set_fill_color(dsc, color);
+        lv_draw_vector_dsc_set_fill_opa(dsc, opa);
+    }
+    lv_draw_vector_dsc_add_path(dsc, path);
+    lv_draw_vector(dsc);
+    lv_draw_vector_dsc_delete(dsc);
+}
+
+inline void path_mask_free(void* buf) {
+    lv_image_cache_drop(buf);
+    lv_draw_buf_destroy(static_cast<lv_draw_buf_t*>(buf));
+}
+
+/// Free a mask after the refresh that may still blit it
+inline void path_mask_release(PathMask& m) noexcept {
+    if (m.buf) {
+        g_path_cache_stats.bytes -= m.buf->data_size;
+        lv_async_call(&path_mask_free, m.buf);
+    }
+    m = {};
+}
+
+/// Render one queued mask into its own buffer, outside of any refresh
+inline bool path_mask_render(PathMask& m) noexcept {
+    const int32_t w = lv_area_get_width(&m.box);
+    const int32_t h = lv_area_get_height(&m.box);
+    lv_draw_buf_t* buf = lv_draw_buf_create(static_cast<uint32_t>(w), static_cast<uint32_t>(h),
+                                            LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    if (!buf) return false;
+    lv_draw_buf_clear(buf, nullptr);
+
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = buf;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer.buf_area = {0, 0, w - 1, h - 1};
+    layer._clip_area = layer.buf_area;
+    layer.phy_clip_area = layer.buf_area;
+
+    lv_matrix_t mtx;
+    lv_matrix_identity(&mtx);
+    mtx.m[0][0] = m.linear[0];
+    mtx.m[0][1] = m.linear[1];
+    mtx.m[1][0] = m.linear[2];
+    mtx.m[1][1] = m.linear[3];
+    mtx.m[0][2] = static_cast<float>(m.frac_x) / 4.0f - static_cast<float>(m.box.x1);
+    mtx.m[1][2] = static_cast<float>(m.frac_y) / 4.0f - static_cast<float>(m.box.y1);
+    path_paint(&layer, m.src, mtx, lv_color_white(), LV_OPA_COVER, m.stroke);
+
+    // Same loop as lv_canvas_finish_layer()
+    while (layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        if (!lv_draw_dispatch_layer(lv_display_get_default(), &layer)) {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+    m.buf = buf;
+    g_path_cache_stats.bytes += buf->data_size;
+    ++g_path_cache_stats.rasterized;
+    return true;
+}
+
+inline void path_mask_render_pending(void*) {
+    g_path_mask_scheduled = false;
+    for (PathMask& m : g_path_masks) {
+        if (m.state != PathMask::PENDING) continue;
+        m.state = path_mask_render(m) ? PathMask::READY : PathMask::FAILED;
+        m.src = nullptr;
+    }
+}
+
+/// Drop the least recently used rendered mask
+inline bool path_mask_evict_lru() noexcept {
+    PathMask* lru = nullptr;
+    for (PathMask& m : g_path_masks) {
+        if ((m.state == PathMask::READY || m.state == PathMask::FAILED) && (!lru || m.used < lru->used)) lru = &m;
+    }
+    if (!lru) return false;
+    path_mask_release(*lru);
+    ++g_path_cache_stats.evicted;
+    return true;
+}
+
+/// Free slot with room for `bytes` more in the budget, or nullptr
+inline PathMask* path_mask_make_room(uint32_t bytes) noexcept {
+    while (g_path_cache_stats.bytes + bytes > g_path_mask_budget) {
+        if (!path_mask_evict_lru()) return nullptr;
+    }
+    for (;;) {
+        for (PathMask& m : g_path_masks) {
+            if (m.state == PathMask::EMPTY) return &m;
+        }
+        if (!path_mask_evict_lru()) return nullptr;
+    }
+}
+
+/**
+ * @brief Add a to at most max dirty areas
+ *
+ * Joins the first area a overlaps, else takes a free slot, else grows the
+ * area whose size grows least.
+ */
+inline void merge_dirty(lv_area_t* areas, uint32_t& count, uint32_t max, const lv_area_t& a) noexcept {
+    const auto size_of = [](const lv_area_t& r) {
+        return static_cast<uint64_t>(lv_area_get_width(&r)) * static_cast<uint64_t>(lv_area_get_height(&r));
+    };
+    uint32_t best = 0;
+    uint64_t best_growth = UINT64_MAX;
+    for (uint32_t i = 0; i < count; ++i) {
+        lv_area_t u;
+        lv_area_join(&u, &areas[i], &a);
+        if (lv_area_is_on(&areas[i], &a)) {
+            areas[i] = u;
+            return;
+        }
+        const uint64_t growth = size_of(u) - size_of(areas[i]);
+        if (growth < best_growth) {
+            best_growth = growth;
+            best = i;
+        }
+    }
+    if (count < max) areas[count++] = a;
+    else lv_area_join(&areas[best], &areas[best], &a);
+}
+
+} // namespace detail
+
+/**
+ * @brief Immutable path whose rasterized coverage is cached between frames
+ *
+ * Created with VectorPath::freeze(). A frozen path is identified by a hash
+ * of its commands and points; drawing it looks up a coverage mask for that
+ * hash at the same transform (scale, rotation and skew, sub-pixel position
+ * to 1/4 px), quality and size. On a hit the mask is blitted as an image,
+ * recolored, at the integer position; moving a path by whole pixels keeps
+ * hitting. On a miss the path is drawn as a vector and its mask rendered
+ * after the refresh, so the first frame costs what it always did.
+ *
+ * Example:
+ * @code
+ * static lv::FrozenPath needle = lv::VectorPath().move_to(0, -4).line_to(90, 0).line_to(0, 4).close().freeze();
+ *
+ * // In a draw event handler:
+ * lv_matrix_t m;
+ * lv_matrix_identity(&m);
+ * lv_matrix_translate(&m, cx, cy);
+ * lv_matrix_rotate(&m, angle);
+ * needle.fill(layer, m, lv::palette::red());
+ * @endcode
+ *
+ * Masks are shared by all frozen paths with the same hash and kept in one
+ * LRU cache (32 masks, cache_budget() bytes). Strokes use round joins and
+ * caps. Masks larger than a quarter of the budget are never cached.
+ */
+class FrozenPath {
+    lv_vector_path_t* m_path = nullptr;
+    uint64_t m_hash = 0;
+
+    void reset() noexcept {
+        if (!m_path) return;
+        for (detail::PathMask& m : detail::g_path_masks) {
+            if (m.state == detail::PathMask::PENDING && m.src == m_path) m = {};
+        }
+        lv_vector_path_delete(m_path);
+        m_path = nullptr;
+    }
+
+    void draw(lv_layer_t* layer, const lv_matrix_t& m, lv_color_t color, lv_opa_t opa, float stroke) const noexcept {
+        using detail::PathMask;
+        const lv_vector_path_t* path = m_path;
+        if (!path || !layer) return;
+
+        // Integer translation is applied at blit time, the rest is part of the key
+        const float tx = m.m[0][2];
+        const float ty = m.m[1][2];
+        int32_t ix = static_cast<int32_t>(tx >= 0 ? tx : tx - 1);
+        int32_t iy = static_cast<int32_t>(ty >= 0 ? ty : ty - 1);
+        int32_t fx = static_cast<int32_t>((tx - static_cast<float>(ix)) * 4.0f + 0.5f);
+        int32_t fy = static_cast<int32_t>((ty - static_cast<float>(iy)) * 4.0f + 0.5f);
+        if (fx == 4) { ++ix; fx = 0; }
+        if (fy == 4) { ++iy; fy = 0; }
+        const float lin[4] = {m.m[0][0], m.m[0][1], m.m[1][0], m.m[1][1]};
+        const auto quality = static_cast<uint8_t>(path->quality);
+
+        PathMask* hit = nullptr;
+        for (PathMask& e : detail::g_path_masks) {
+            if (e.state != PathMask::EMPTY && e.hash == m_hash && e.quality == quality && e.stroke == stroke &&
+                e.frac_x == fx && e.frac_y == fy && e.linear[0] == lin[0] && e.linear[1] == lin[1] &&
+                e.linear[2] == lin[2] && e.linear[3] == lin[3]) {
+                hit = &e;
+                break;
+            }
+        }
+
+        if (hit && hit->state == PathMask::READY) {
+            hit->used = ++detail::g_path_mask_clock;
+            ++detail::g_path_cache_stats.hits;
+            lv_draw_image_dsc_t img;
+            lv_draw_image_dsc_init(&img);
+            img.src = hit->buf;
+            img.recolor = color;
+            img.recolor_opa = LV_OPA_COVER;
+            img.opa = opa;
+            lv_area_t area = hit->box;
+            lv_area_move(&area, ix, iy);
+            lv_draw_image(layer, &img, &area);
+            return;
+        }
+
+        detail::path_paint(layer, path, m, color, opa, stroke);
+        if (hit) {
+            hit->used = ++detail::g_path_mask_clock;
+            ++detail::g_path_cache_stats.misses;
+            return;
+        }
+
+        lv_matrix_t key = m;
+        key.m[0][2] = static_cast<float>(fx) / 4.0f;
+        key.m[1][2] = static_cast<float>(fy) / 4.0f;
+        const lv_area_t box = detail::path_box(path, key, stroke);
+        const uint64_t bytes = static_cast<uint64_t>(lv_area_get_width(&box)) *
+                               static_cast<uint64_t>(lv_area_get_height(&box)) * 4;
+        if (bytes > detail::g_path_mask_budget / 4) {
+            ++detail::g_path_cache_stats.uncached;
+            return;
+        }
+        ++detail::g_path_cache_stats.misses;
+
+        PathMask* slot = detail::path_mask_make_room(static_cast<uint32_t>(bytes));
+        if (!slot) return;
+        *slot = {m_hash, {lin[0], lin[1], lin[2], lin[3]}, static_cast<int8_t>(fx), static_cast<int8_t>(fy),
+                 quality, PathMask::PENDING, stroke, box, path, nullptr, ++detail::g_path_mask_clock};
+        if (!detail::g_path_mask_scheduled) {
+            detail::g_path_mask_scheduled = lv_async_call(&detail::path_mask_render_pending, nullptr) == LV_RESULT_OK;
+        }
+    }
+
+public:
+    /// Empty frozen path
+    FrozenPath() noexcept = default;
+
+    /// Take over a path (same as path.freeze())
+    explicit FrozenPath(VectorPath&& path) noexcept
+        : m_path(path.m_path), m_hash(m_path ? detail::path_hash(m_path) : 0) {
+        path.m_path = nullptr;
+    }
+
+    /// Non-copyable
+    FrozenPath(const FrozenPath&) = delete;
+    FrozenPath& operator=(const FrozenPath&) = delete;
+
+    /// Moveable (queued masks follow the path)
+    FrozenPath(FrozenPath&& other) noexcept : m_path(other.m_path), m_hash(other.m_hash) {
+        other.m_path = nullptr;
+    }
+
+    FrozenPath& operator=(FrozenPath&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_path = other.m_path;
+            m_hash = other.m_hash;
+            other.m_path = nullptr;
+        }
+        return *this;
+    }
+
+    /// Masks still queued for this path are dropped; rendered ones stay cached
+    ~FrozenPath() { reset(); }
+
+    /// Get underlying pointer
+    [[nodiscard]] const lv_vector_path_t* get() const noexcept { return m_path; }
+
+    /// Check if valid
+    [[nodiscard]] bool valid() const noexcept { return m_path != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+
+    /// Hash of the path's commands and points
+    [[nodiscard]] uint64_t hash() const noexcept { return m_hash; }
+
+    /// Get bounding box (untransformed)
+    [[nodiscard]] lv_area_t bounding_box() const noexcept {
+        lv_area_t area{};
+        lv_vector_path_get_bounding(m_path, &area);
+        return area;
+    }
+
+    /// Fill the path transformed by m
+    void fill(lv_layer_t* layer, const lv_matrix_t& m, lv_color_t color, lv_opa_t opa = LV_OPA_COVER) const noexcept {
+        draw(layer, m, color, opa, 0.0f);
+    }
+
+    /// Fill the path untransformed
+    void fill(lv_layer_t* layer, lv_color_t color, lv_opa_t opa = LV_OPA_COVER) const noexcept {
+        lv_matrix_t m;
+        lv_matrix_identity(&m);
+        draw(layer, m, color, opa, 0.0f);
+    }
+
+    /// Stroke the path transformed by m (width before transform)
+    void stroke(lv_layer_t* layer, const lv_matrix_t& m, lv_color_t color, float width,
+                lv_opa_t opa = LV_OPA_COVER) const noexcept {
+        draw(layer, m, color, opa, width > 0 ? width : 1.0f);
+    }
+
+    // ==================== Cache ====================
+
+    /// Bytes of mask memory all frozen paths may use (default 256KB)
+    static void cache_budget(uint32_t bytes) noexcept {
+        detail::g_path_mask_budget = bytes;
+        while (detail::g_path_cache_stats.bytes > bytes && detail::path_mask_evict_lru()) {}
+    }
+
+    /// Drop every cached mask
+    static void clear_cache() noexcept {
+        for (detail::PathMask& m : detail::g_path_masks) {
+            if (m.state == detail::PathMask::READY || m.state == detail::PathMask::FAILED) detail::path_mask_release(m);
+        }
+    }
+
+    /// Cache statistics
+    [[nodiscard]] static const PathCacheStats& cache_stats() noexcept { return detail::g_path_cache_stats; }
+
+    /// Print cache statistics with LV_LOG_USER
+    static void log_cache() noexcept {
+        [[maybe_unused]] const PathCacheStats& s = detail::g_path_cache_stats;
+        LV_LOG_USER("FrozenPath: %u hits, %u misses, %u uncached, %u rendered, %u evicted, %uKB",
+                    static_cast<unsigned>(s.hits), static_cast<unsigned>(s.misses),
+                    static_cast<unsigned>(s.uncached), static_cast<unsigned>(s.rasterized),
+                    static_cast<unsigned>(s.evicted), static_cast<unsigned>(s.bytes / 1024));
+    }
+};
+
+inline FrozenPath VectorPath::freeze() noexcept {
+    return FrozenPath(std::move(*this));
+}
+
+// ==================== VectorScene ====================
+
+/// VectorScene statistics
+struct SceneStats {
+    uint32_t passes = 0;          ///< Draw passes (one per dirty area LVGL renders)
+    uint32_t last_drawn = 0;      ///< Nodes drawn in the last pass
+    uint32_t last_skipped = 0;    ///< Visible nodes outside the last pass's clip area
+    uint32_t changes = 0;         ///< Node changes that needed a redraw
+    uint32_t invalidations = 0;   ///< Areas handed to LVGL
+};
+
+/**
+ * @brief Retained set of vector paths drawn on an object
+ *
+ * Paths are added once with their fill, stroke and transform; changing a
+ * node afterwards only invalidates the node's old and new bounding box, so
+ * LVGL redraws those areas and the nodes that touch them instead of the
+ * whole drawing. Changes are collected into a few dirty areas and handed
+ * to LVGL when the display refreshes. Nodes are drawn in the order added,
+ * all in one vector draw task, relative to the object's top-left corner
+ * and clipped to it.
+ *
+ * Example:
+ * @code
+ * lv::VectorScene scene(gauge, 128);
+ * scene.add(lv::VectorPath().circle(100, 100, 90)).stroke_color(lv::palette::grey()).stroke_width(4).fill_opa(LV_OPA_TRANSP);
+ * auto needle = scene.add(lv::VectorPath().move_to(0, -3).line_to(80, 0).line_to(0, 3).close());
+ * auto alarm = scene.add(lv::VectorPath().circle(100, 160, 8)).fill_color(lv::palette::red()).visible(false);
+ *
+ * // Each tick: only the needle's (and the alarm's) areas are redrawn
+ * lv_matrix_t m;
+ * lv_matrix_identity(&m);
+ * lv_matrix_translate(&m, 100, 100);
+ * lv_matrix_rotate(&m, angle);
+ * needle.transform(m);
+ * alarm.visible(value > limit);
+ * @endcode
+ *
+ * Non-movable (registered as object and display event callback with
+ * `this` as user data). Strokes use round joins and caps. Removed nodes
+ * keep their slot; clear() frees them all.
+ */
+class VectorScene {
+    struct Item {
+        lv_vector_path_t* path;   ///< nullptr = removed
+        lv_matrix_t matrix;
+        lv_area_t box;            ///< Drawn area relative to the object
+        lv_color_t fill_color;
+        lv_color_t stroke_color;
+        float stroke_width;
+        lv_opa_t fill_opa;
+        lv_opa_t stroke_opa;
+        bool visible;
+    };
+
+    static constexpr uint32_t DIRTY_AREAS = 4;
+
+    lv_obj_t* m_obj = nullptr;
+    lv_display_t* m_display = nullptr;
+    Item* m_items = nullptr;
+    uint32_t m_capacity = 0;
+    uint32_t m_count = 0;
+    lv_area_t m_dirty[DIRTY_AREAS] = {};
+    uint32_t m_dirty_count = 0;
+    SceneStats m_stats;
+
+    void mark_dirty(const lv_area_t& a) noexcept {
+        detail::merge_dirty(m_dirty, m_dirty_count, DIRTY_AREAS, a);
+        // An idle display pauses its refresh timer: wake it so REFR_START comes
+        if (m_display) {
+            if (lv_timer_t* t = lv_display_get_refr_timer(m_display)) lv_timer_resume(t);
+        }
+    }
+
+    void changed(const Item& it) noexcept {
+        if (it.visible) mark_dirty(it.box);
+        ++m_stats.changes;
+    }
+
+    template<typename F>
+    void reshape(Item& it, F&& apply) noexcept {
+        if (it.visible) mark_dirty(it.box);
+        apply();
+        it.box = detail::path_box(it.path, it.matrix, it.stroke_width);
+        changed(it);
+    }
+
+    static void obj_event_cb(lv_event_t* e) {
+        auto* self = static_cast<VectorScene*>(lv_event_get_user_data(e));
+        if (lv_event_get_code(e) == LV_EVENT_DRAW_MAIN) {
+            self->draw(lv_event_get_layer(e));
+            return;
+        }
+        // LV_EVENT_DELETE
+        if (self->m_display) lv_display_remove_event_cb_with_user_data(self->m_display, &display_event_cb, self);
+        self->m_obj = nullptr;
+        self->m_display = nullptr;
+    }
+
+    static void display_event_cb(lv_event_t* e) {
+        static_cast<VectorScene*>(lv_event_get_user_data(e))->flush();
+    }
+
+    /// Hand the collected dirty areas to LVGL (at LV_EVENT_REFR_START)
+    void flush() noexcept {
+        if (!m_obj || m_dirty_count == 0) return;
+        lv_area_t coords;
+        lv_obj_get_coords(m_obj, &coords);
+        for (uint32_t i = 0; i < m_dirty_count; ++i) {
+            lv_area_t a = m_dirty[i];
+            lv_area_move(&a, coords.x1, coords.y1);
+            lv_obj_invalidate_area(m_obj, &a);
+        }
+        m_stats.invalidations += m_dirty_count;
+        m_dirty_count = 0;
+    }
+
+    void draw(lv_layer_t* layer) noexcept {
+        lv_area_t coords;
+        lv_obj_get_coords(m_obj, &coords);
+        lv_draw_vector_dsc_t* dsc = nullptr;
+        uint32_t drawn = 0;
+        uint32_t skipped = 0;
+
+        for (uint32_t i = 0; i < m_count; ++i) {
+            const Item& it = m_items[i];
+            if (!it.path || !it.visible) continue;
+            lv_area_t a = it.box;
+            lv_area_move(&a, coords.x1, coords.y1);
+            lv_area_t visible;
+            if (!lv_area_intersect(&visible, &a, &layer->_clip_area)) {
+                ++skipped;
+                continue;
+            }
+            if (!dsc && !(dsc = lv_draw_vector_dsc_create(layer))) return;
+
+            lv_matrix_t m = it.matrix;
+            m.m[0][2] += static_cast<float>(coords.x1);
+            m.m[1][2] += static_cast<float>(coords.y1);
+            lv_draw_vector_dsc_set_transform(dsc, &m);
+            lv_draw_vector_dsc_set_fill_color(dsc, it.fill_color);
+            lv_draw_vector_dsc_set_fill_opa(dsc, it.fill_opa);
+            lv_draw_vector_dsc_set_stroke_color(dsc, it.stroke_color);
+            lv_draw_vector_dsc_set_stroke_opa(dsc, it.stroke_width > 0 ? it.stroke_opa : LV_OPA_TRANSP);
+            lv_draw_vector_dsc_set_stroke_width(dsc, it.stroke_width);
+            lv_draw_vector_dsc_set_stroke_cap(dsc, LV_VECTOR_STROKE_CAP_ROUND);
+            lv_draw_vector_dsc_set_stroke_join(dsc, LV_VECTOR_STROKE_JOIN_ROUND);
+            lv_draw_vector_dsc_add_path(dsc, it.path);
+            ++drawn;
+        }
+        if (dsc) {
+            lv_draw_vector(dsc);
+            lv_draw_vector_dsc_delete(dsc);
+        }
+        ++m_stats.passes;
+        m_stats.last_drawn = drawn;
+        m_stats.last_skipped = skipped;
+    }
+
+public:
+    /**
+     * @brief Handle to one node of a scene
+     *
+     * Setters only invalidate when the value changes. A handle stays valid
+     * until the node is removed or the scene cleared.
+     */
+    class Node {
+        friend class VectorScene;
+
+        VectorScene* m_scene = nullptr;
+        uint32_t m_index = 0;
+
+        Node(VectorScene* scene, uint32_t index) noexcept : m_scene(scene), m_index(index) {}
+
+        [[nodiscard]] Item* item() const noexcept {
+            if (!m_scene || m_index >= m_scene->m_count) return nullptr;
+            Item* it = &m_scene->m_items[m_index];
+            return it->path ? it : nullptr;
+        }
+
+    public:
+        /// Invalid handle
+        Node() noexcept = default;
+
+        /// Check if the node exists
+        [[nodiscard]] bool valid() const noexcept { return item() != nullptr; }
+        explicit operator bool() const noexcept { return valid(); }
+
+        /// Position in draw order
+        [[nodiscard]] uint32_t index() const noexcept { return m_index; }
+
+        /// Set fill color
+        Node& fill_color(lv_color_t color) noexcept {
+            Item* it = item();
+            if (it && !lv_color_eq(it->fill_color, color)) {
+                it->fill_color = color;
+                m_scene->changed(*it);
+            }
+            return *this;
+        }
+
+        /// Set fill opacity (LV_OPA_TRANSP = no fill)
+        Node& fill_opa(lv_opa_t opa) noexcept {
+            Item* it = item();
+            if (it && it->fill_opa != opa) {
+                it->fill_opa = opa;
+                m_scene->changed(*it);
+            }
+            return *this;
+        }
+
+        /// Set stroke color
+        Node& stroke_color(lv_color_t color) noexcept {
+            Item* it = item();
+            if (it && !lv_color_eq(it->stroke_color, color)) {
+                it->stroke_color = color;
+                m_scene->changed(*it);
+            }
+            return *this;
+        }
+
+        /// Set stroke opacity
+        Node& stroke_opa(lv_opa_t opa) noexcept {
+            Item* it = item();
+            if (it && it->stroke_opa != opa) {
+                it->stroke_opa = opa;
+                m_scene->changed(*it);
+            }
+            return *this;
+        }
+
+        /// Set stroke width (0 = no stroke)
+        Node& stroke_width(float width) noexcept {
+            Item* it = item();
+            if (it && it->stroke_width != width) m_scene->reshape(*it, [&] { it->stroke_width = width; });
+            return *this;
+        }
+
+        /// Set the transformation, relative to the object's top-left corner
+        Node& transform(const lv_matrix_t& matrix) noexcept {
+            Item* it = item();
+            if (it && std::memcmp(&it->matrix, &matrix, sizeof(lv_matrix_t)) != 0) {
+                m_scene->reshape(*it, [&] { it->matrix = matrix; });
+            }
+            return *this;
+        }
+
+        /// Get the transformation
+        [[nodiscard]] lv_matrix_t transform() const noexcept {
+            const Item* it = item();
+            lv_matrix_t m;
+            if (it) m = it->matrix;
+            else lv_matrix_identity(&m);
+            return m;
+        }
+
+        /// Show or hide the node
+        Node& visible(bool on) noexcept {
+            Item* it = item();
+            if (it && it->visible != on) {
+                it->visible = on;
+                m_scene->mark_dirty(it->box);
+                ++m_scene->m_stats.changes;
+            }
+            return *this;
+        }
+
+        /// Check if the node is shown
+        [[nodiscard]] bool visible() const noexcept {
+            const Item* it = item();
+            return it && it->visible;
+        }
+
+        /// Replace the node's path (takes it over)
+        Node& path(VectorPath&& path) noexcept { return this->path(path); }
+
+        Node& path(VectorPath& path) noexcept {
+            Item* it = item();
+            if (!it || !path) return *this;
+            m_scene->reshape(*it, [&] {
+                lv_vector_path_delete(it->path);
+                it->path = path.m_path;
+                path.m_path = nullptr;
+            });
+            return *this;
+        }
+
+        /// Remove the node (its slot is not reused)
+        void remove() noexcept {
+            Item* it = item();
+            if (!it) return;
+            m_scene->changed(*it);
+            lv_vector_path_delete(it->path);
+            it->path = nullptr;
+        }
+    };
+
+    /**
+     * @brief Attach a scene to an object
+     *
+     * @param obj Object to draw on (drawn after its own main part)
+     * @param capacity Maximum number of nodes
+     */
+    explicit VectorScene(lv_obj_t* obj, uint32_t capacity = 64) noexcept {
+        if (!obj || capacity == 0) return;
+        m_items = static_cast<Item*>(lv_malloc(sizeof(Item) * capacity));
+        if (!m_items) {
+            LV_LOG_WARN("VectorScene: out of memory for %u nodes", static_cast<unsigned>(capacity));
+            return;
+        }
+        m_capacity = capacity;
+        m_obj = obj;
+        m_display = lv_obj_get_display(obj);
+        lv_obj_add_event_cb(obj, &obj_event_cb, LV_EVENT_DRAW_MAIN, this);
+        lv_obj_add_event_cb(obj, &obj_event_cb, LV_EVENT_DELETE, this);
+        lv_display_add_event_cb(m_display, &display_event_cb, LV_EVENT_REFR_START, this);
+    }
+
+    /// Detach from the object and free the paths
+    ~VectorScene() {
+        if (m_obj) {
+            lv_obj_remove_event_cb_with_user_data(m_obj, &obj_event_cb, this);
+            lv_display_remove_event_cb_with_user_data(m_display, &display_event_cb, this);
+            lv_obj_invalidate(m_obj);
+        }
+        for (uint32_t i = 0; i < m_count; ++i) {
+            if (m_items[i].path) lv_vector_path_delete(m_items[i].path);
+        }
+        lv_free(m_items);
+    }
+
+    VectorScene(const VectorScene&) = delete;
+    VectorScene& operator=(const VectorScene&) = delete;
+
+    /// Check if the scene is attached
+    [[nodiscard]] bool active() const noexcept { return m_obj != nullptr; }
+
+    /**
+     * @brief Add a path on top of the existing nodes
+     *
+     * Takes over the path (it is left empty). Filled black, no stroke,
+     * identity transform. Returns an invalid handle if the scene is full.
+     */
+    Node add(VectorPath&& path) noexcept { return add(path); }
+
+    Node add(VectorPath& path) noexcept {
+        if (!path || m_count == m_capacity) {
+            if (path) LV_LOG_WARN("VectorScene: all %u nodes used", static_cast<unsigned>(m_capacity));
+            return {};
+        }
+        Item& it = m_items[m_count];
+        it.path = path.m_path;
+        path.m_path = nullptr;
+        lv_matrix_identity(&it.matrix);
+        it.fill_color = lv_color_black();
+        it.stroke_color = lv_color_black();
+        it.stroke_width = 0;
+        it.fill_opa = LV_OPA_COVER;
+        it.stroke_opa = LV_OPA_COVER;
+        it.visible = true;
+        it.box = detail::path_box(it.path, it.matrix, 0);
+        mark_dirty(it.box);
+        return {this, m_count++};
+    }
+
+    /// Handle of the node at a draw order position
+    [[nodiscard]] Node node(uint32_t index) noexcept { return {this, index}; }
+
+    /// Number of slots used (including removed nodes)
+    [[nodiscard]] uint32_t size() const noexcept { return m_count; }
+
+    /// Remove every node
+    VectorScene& clear() noexcept {
+        for (uint32_t i = 0; i < m_count; ++i) {
+            Item& it = m_items[i];
+            if (!it.path) continue;
+            if (it.visible) mark_dirty(it.box);
+            lv_vector_path_delete(it.path);
+        }
+        m_count = 0;
+        return *this;
+    }
+
+    /// Scene statistics
+    [[nodiscard]] const SceneStats& stats() const noexcept { return m_stats; }
+
+    /// Reset the statistics
+    VectorScene& reset_stats() noexcept {
+        m_stats = {};
+        return *this;
+    }
+
+    /// Print statistics with LV_LOG_USER
+    void log() const noexcept {
+        LV_LOG_USER("VectorScene: %u nodes, %u passes, last drew %u skipped %u, %u changes, %u areas invalidated",
+                    static_cast<unsigned>(m_count), static_cast<unsigned>(m_stats.passes),
+                    static_cast<unsigned>(m_stats.last_drawn), static_cast<unsigned>(m_stats.last_skipped),
+                    static_cast<unsigned>(m_stats.changes), static_cast<unsigned>(m_stats.invalidations));
+    }
+};
+
 // ==================== Matrix Helpers ====================
 
 namespace matrix {
@@ -51,13 +51,29 @@
 #include "core/color.hpp"
 #include "core/font.hpp"
 #include "core/display.hpp"
+#include "core/render_threads.hpp"
+#include "core/async_flush.hpp"
+#include "core/refresh_policy.hpp"
+#include "core/tiled_renderer.hpp"
+#include "core/flush_transform.hpp"
+#include "core/flush_filter.hpp"
+#include "core/adaptive_quality.hpp"
+#include "core/occlusion_culler.hpp"
 #include "core/app.hpp"
 #include "core/component.hpp"
 #include "core/anim.hpp"
 #include "core/theme.hpp"
 #include "core/screen.hpp"
 #include "core/indev.hpp"
+#include "core/event_indev.hpp"
+#include "core/indev_tap.hpp"
+#include "core/input_record.hpp"
+#include "core/touch_resampler.hpp"
+#include "core/gesture.hpp"
+#include "core/scroll_physics.hpp"
+#include "core/metrics.hpp"
 #include "core/focus.hpp"
+#include "core/spatial_focus.hpp"
 #include "core/timer.hpp"
 #include "core/image.hpp"
 #include "core/font_loader.hpp"
@@ -75,6 +91,10 @@
 #include "layout/flex.hpp"
 #include "layout/grid.hpp"
 
+// Display backends
+#include "display/fb_display.hpp"
+#include "display/drm_display.hpp"
+
 // Widgets - Basic
 #include "widgets/box.hpp"
 #include "widgets/label.hpp"
@@ -135,6 +155,7 @@
 // Lottie animation (requires ThorVG)
 #if LV_USE_LOTTIE
 #include "widgets/lottie.hpp"
+#include "widgets/lottie_worker.hpp"
 #endif
 
 // Libs (optional)
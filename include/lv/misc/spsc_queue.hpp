@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * @file spsc_queue.hpp
+ * @brief Fixed-capacity lock-free single-producer/single-consumer queue
+ *
+ * Used to hand data from a worker thread (input reader, flush thread,
+ * rasterizer) to the LVGL thread without locks or heap allocation.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace lv {
+
+/**
+ * @brief Lock-free SPSC ring buffer with compile-time capacity
+ *
+ * Exactly one thread may call push() and exactly one (other) thread may call
+ * pop()/peek(). Capacity must be a power of two; one slot is never wasted
+ * because head/tail are free-running counters.
+ *
+ * @code
+ * lv::SpscQueue<lv_indev_data_t, 64> queue;
+ *
+ * // Producer thread
+ * queue.push(sample);
+ *
+ * // LVGL thread
+ * lv_indev_data_t data;
+ * while (queue.pop(data)) { ... }
+ * @endcode
+ *
+ * @tparam T Trivially copyable element type
+ * @tparam N Capacity (power of two)
+ */
+template<typename T, size_t N>
+class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "SpscQueue element must be trivially copyable");
+
+    static constexpr size_t MASK = N - 1;
+
+    alignas(64) std::atomic<size_t> m_head{0};  ///< Next slot to read (consumer-owned)
+    alignas(64) std::atomic<size_t> m_tail{0};  ///< Next slot to write (producer-owned)
+    T m_items[N];
+
+public:
+    SpscQueue() noexcept = default;
+
+    // Non-copyable, non-movable (threads hold references)
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// Push an element (producer thread). Returns false if full.
+    bool push(const T& item) noexcept {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= N) {
+            return false;
+        }
+        m_items[tail & MASK] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Pop the oldest element (consumer thread). Returns false if empty.
+    bool pop(T& out) noexcept {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = m_items[head & MASK];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Peek at the oldest element without removing it (consumer thread)
+    [[nodiscard]] const T* peek() const noexcept {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &m_items[head & MASK];
+    }
+
+    /// Check if empty (approximate when called from the producer)
+    [[nodiscard]] bool empty() const noexcept {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    /// Number of queued elements (approximate under concurrency)
+    [[nodiscard]] size_t size() const noexcept {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    /// Compile-time capacity
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+};
+
+} // namespace lv
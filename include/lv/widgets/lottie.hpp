@@ -13,12 +13,124 @@
 
 #if LV_USE_LOTTIE
 
+#include <src/widgets/lottie/lv_lottie_private.h>   // ThorVG canvas and animation
+#include <src/misc/lv_anim_private.h>                 // Frame range, exec_cb
 #include "../core/object.hpp"
 #include "../core/event.hpp"
 #include "../core/style.hpp"
 
 namespace lv {
 
+namespace detail {
+
+/// Pre-rendered frames of one Lottie widget (see Lottie::cache_frames())
+struct LottieFrameCache {
+    lv_obj_t* obj;
+    lv_draw_buf_t* own_buf;          ///< The widget's buffer (ThorVG's usual target)
+    lv_anim_exec_xcb_t live_exec;    ///< lv_lottie's exec_cb
+    lv_draw_buf_t** frames;
+    uint32_t count;
+    uint32_t ready;                  ///< Frames rendered so far
+    int32_t first;                   ///< Animation value of frames[0]
+    lv_timer_t* timer;               ///< Background rendering
+};
+
+/// Frame time slice of background caching per timer tick
+inline constexpr uint32_t LOTTIE_CACHE_SLICE_MS = 4;
+
+inline void lottie_cache_delete_cb(lv_event_t* e);
+
+[[nodiscard]] inline LottieFrameCache* lottie_cache_find(lv_obj_t* obj) noexcept {
+    const uint32_t n = lv_obj_get_event_count(obj);
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_event_dsc_t* dsc = lv_obj_get_event_dsc(obj, i);
+        if (lv_event_dsc_get_cb(dsc) == &lottie_cache_delete_cb) {
+            return static_cast<LottieFrameCache*>(lv_event_dsc_get_user_data(dsc));
+        }
+    }
+    return nullptr;
+}
+
+inline void lottie_set_target(lv_lottie_t* lottie, lv_draw_buf_t* buf) noexcept {
+    tvg_swcanvas_set_target(lottie->tvg_canvas, reinterpret_cast<uint32_t*>(buf->data), buf->header.stride / 4,
+                            buf->header.w, buf->header.h, TVG_COLORSPACE_ARGB8888);
+}
+
+/// Rasterize one frame of a Lottie widget's animation into dst
+inline void lottie_render(lv_lottie_t* lottie, lv_draw_buf_t* dst, int32_t frame) noexcept {
+    lv_draw_buf_clear(dst, nullptr);
+    lottie_set_target(lottie, dst);
+    tvg_animation_set_frame(lottie->tvg_anim, static_cast<float>(frame));
+    tvg_canvas_update(lottie->tvg_canvas);
+    tvg_canvas_draw(lottie->tvg_canvas);
+    tvg_canvas_sync(lottie->tvg_canvas);
+}
+
+/// Rasterize frames[ready] directly into its buffer
+inline void lottie_cache_render_next(LottieFrameCache* c) noexcept {
+    lottie_render(reinterpret_cast<lv_lottie_t*>(c->obj), c->frames[c->ready],
+                  c->first + static_cast<int32_t>(c->ready));
+    ++c->ready;
+}
+
+inline void lottie_cached_exec_cb(void* var, int32_t v) {
+    auto* obj = static_cast<lv_obj_t*>(var);
+    LottieFrameCache* c = lottie_cache_find(obj);
+    if (!c || !lv_obj_is_visible(obj)) return;
+    const int32_t i = LV_CLAMP(0, v - c->first, static_cast<int32_t>(c->count) - 1);
+    lv_image_set_src(obj, c->frames[i]);
+}
+
+/// All frames rendered: switch the widget from ThorVG to the frame ring
+inline void lottie_cache_finish(LottieFrameCache* c) noexcept {
+    lottie_set_target(reinterpret_cast<lv_lottie_t*>(c->obj), c->own_buf);
+    if (c->timer) {
+        lv_timer_delete(c->timer);
+        c->timer = nullptr;
+    }
+    lv_anim_t* anim = lv_lottie_get_anim(c->obj);
+    anim->exec_cb = &lottie_cached_exec_cb;
+    lottie_cached_exec_cb(c->obj, anim->current_value);
+}
+
+inline void lottie_cache_timer_cb(lv_timer_t* t) {
+    auto* c = static_cast<LottieFrameCache*>(lv_timer_get_user_data(t));
+    const uint32_t start = lv_tick_get();
+    while (c->ready < c->count && lv_tick_elaps(start) < LOTTIE_CACHE_SLICE_MS) lottie_cache_render_next(c);
+    if (c->ready == c->count) {
+        lottie_cache_finish(c);
+    } else {
+        lottie_set_target(reinterpret_cast<lv_lottie_t*>(c->obj), c->own_buf);
+    }
+}
+
+/// Back to live rendering (unless the widget is being deleted); frees the frames
+inline void lottie_cache_free(LottieFrameCache* c, bool deleting = false) noexcept {
+    if (c->timer) lv_timer_delete(c->timer);
+    if (!deleting) {
+        lottie_set_target(reinterpret_cast<lv_lottie_t*>(c->obj), c->own_buf);
+        if (lv_anim_t* anim = lv_lottie_get_anim(c->obj); anim && anim->exec_cb == &lottie_cached_exec_cb) {
+            anim->exec_cb = c->live_exec;
+        }
+        if (lv_image_get_src(c->obj) != c->own_buf) lv_image_set_src(c->obj, c->own_buf);
+    }
+    for (uint32_t i = 0; i < c->count; ++i) {
+        if (!c->frames[i]) continue;
+        lv_image_cache_drop(c->frames[i]);
+        lv_draw_buf_destroy(c->frames[i]);
+    }
+    lv_free(c->frames);
+    lv_free(c);
+}
+
+inline void lottie_cache_delete_cb(lv_event_t* e) {
+    lottie_cache_free(static_cast<LottieFrameCache*>(lv_event_get_user_data(e)), true);
+}
+
+} // namespace detail
+
+class LottieAsset;
+
 /**
  * @brief Lottie animation widget wrapper
  *
@@ -39,6 +151,12 @@ namespace lv {
  *       .buffer(128, 128, buf)
  *       .src_file("path/to/animation.json")
  *       .center();
+ *
+ *   // Looping animation: rasterize every frame once, then only blit
+ *   lv::Lottie::create(parent)
+ *       .buffer(128, 128, buf)
+ *       .src_data(animation_json, animation_size)
+ *       .cache_frames(2 * 1024 * 1024, true);   // Up to 2 MB, rendered in the background
  * @endcode
  *
  * Size: sizeof(void*) - 4 or 8 bytes
@@ -182,8 +300,395 @@ public:
     Lottie& loop() noexcept {
         return repeat(LV_ANIM_REPEAT_INFINITE);
     }
+
+    // ==================== Frame Cache ====================
+
+    /**
+     * @brief Pre-render every frame once and play them back as images
+     *
+     * Each frame of the animation is rasterized by ThorVG into its own
+     * ARGB8888 draw buffer; afterwards playback only switches the image
+     * source, with no vector rendering. If the frames would take more than
+     * budget bytes (or allocation fails) the widget keeps rendering live.
+     *
+     * With background, frames are rendered on the LVGL thread a few
+     * milliseconds per timer tick (the widget's ThorVG canvas belongs to the
+     * LVGL thread) and the widget renders live until all are ready.
+     *
+     * Call after the source and buffer are set; changing either later
+     * needs uncache_frames() first. Freed with the widget.
+     *
+     * @param budget Memory limit for all frames in bytes
+     * @param background Spread rendering over timer ticks instead of now
+     */
+    Lottie& cache_frames(uint32_t budget, bool background = false) noexcept {
+        uncache_frames();
+        lv_anim_t* anim = get_anim();
+        lv_draw_buf_t* own = lv_canvas_get_draw_buf(m_obj);
+        if (!anim || !own || !reinterpret_cast<lv_lottie_t*>(m_obj)->tvg_anim) {
+            LV_LOG_WARN("Lottie: set a buffer and source before caching frames");
+            return *this;
+        }
+        const int32_t first = LV_MIN(anim->start_value, anim->end_value);
+        const uint32_t count = static_cast<uint32_t>(LV_ABS(anim->end_value - anim->start_value) + 1);
+        if (static_cast<uint64_t>(count) * own->data_size > budget) {
+            LV_LOG_WARN("Lottie: %u frames need %uKB, over the %uKB budget; rendering live",
+                        static_cast<unsigned>(count),
+                        static_cast<unsigned>(static_cast<uint64_t>(count) * own->data_size / 1024),
+                        static_cast<unsigned>(budget / 1024));
+            return *this;
+        }
+
+        auto* c = static_cast<detail::LottieFrameCache*>(lv_malloc_zeroed(sizeof(detail::LottieFrameCache)));
+        if (!c) return *this;
+        c->obj = m_obj;
+        c->own_buf = own;
+        c->live_exec = anim->exec_cb;
+        c->first = first;
+        c->frames = static_cast<lv_draw_buf_t**>(lv_malloc_zeroed(sizeof(lv_draw_buf_t*) * count));
+        c->count = c->frames ? count : 0;
+        const bool premultiplied = lv_draw_buf_has_flag(own, LV_IMAGE_FLAGS_PREMULTIPLIED);
+        for (uint32_t i = 0; i < c->count; ++i) {
+            c->frames[i] = lv_draw_buf_create(own->header.w, own->header.h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+            if (!c->frames[i]) {
+                LV_LOG_WARN("Lottie: out of memory for cached frames; rendering live");
+                c->count = i;
+                break;
+            }
+            if (premultiplied) lv_draw_buf_set_flag(c->frames[i], LV_IMAGE_FLAGS_PREMULTIPLIED);
+        }
+        if (!c->frames || c->count < count) {
+            detail::lottie_cache_free(c);
+            return *this;
+        }
+        lv_obj_add_event_cb(m_obj, &detail::lottie_cache_delete_cb, LV_EVENT_DELETE, c);
+
+        if (background) {
+            c->timer = lv_timer_create(&detail::lottie_cache_timer_cb, 0, c);
+        } else {
+            while (c->ready < c->count) detail::lottie_cache_render_next(c);
+            detail::lottie_cache_finish(c);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Drop the frame cache and render live again
+     */
+    Lottie& uncache_frames() noexcept {
+        if (detail::LottieFrameCache* c = detail::lottie_cache_find(m_obj)) {
+            lv_obj_remove_event_cb_with_user_data(m_obj, &detail::lottie_cache_delete_cb, c);
+            detail::lottie_cache_free(c);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Check if playback comes from cached frames
+     */
+    [[nodiscard]] bool frames_cached() const noexcept {
+        const detail::LottieFrameCache* c = detail::lottie_cache_find(m_obj);
+        return c && c->ready == c->count;
+    }
+
+    // ==================== Shared Asset ====================
+
+    /**
+     * @brief Show a shared, already parsed animation (see LottieAsset)
+     *
+     * Replaces buffer()/src_*() for this widget; playback controls stay
+     * per widget.
+     */
+    Lottie& asset(LottieAsset& asset) noexcept;
+};
+
+/**
+ * @brief A Lottie animation parsed once and shown by many Lottie widgets
+ *
+ * Each lv_lottie parses its JSON into its own ThorVG scene and rasterizes
+ * into its own buffer. A LottieAsset parses once (into a hidden lv_lottie)
+ * and renders frames for any number of attached widgets: widgets showing
+ * the same frame show the same buffer, so N synchronized copies cost one
+ * parse, one rasterization per frame and one buffer.
+ *
+ * @code
+ *   lv::LottieAsset spinner(spinner_json, sizeof(spinner_json), 64, 64);
+ *   spinner.cache_frames(512 * 1024);   // Optional: pre-render the loop once
+ *   for (auto& card : cards) {
+ *       lv::Lottie::create(card).asset(spinner).align(lv::kAlign::top_right);
+ *   }
+ * @endcode
+ *
+ * Every widget keeps its own lv_anim (pause, duration, repeat). A frame
+ * buffer is only re-rendered while a single widget shows it, so there is
+ * at most one per attached widget and usually one in total. Non-movable
+ * (widgets keep a pointer); widgets still attached when it is destroyed
+ * go blank.
+ */
+class LottieAsset {
+public:
+    /// Widgets per asset
+    static constexpr uint32_t MAX_VIEWERS = 16;
+
+private:
+    struct Slot {
+        lv_draw_buf_t* buf = nullptr;
+        int32_t frame = -1;
+        uint8_t refs = 0;
+    };
+    struct Viewer {
+        lv_obj_t* obj = nullptr;
+        int8_t slot = -1;
+    };
+
+    lv_obj_t* m_obj = nullptr;     ///< Hidden lv_lottie holding the parsed scene
+    lv_draw_buf_t* m_own = nullptr;
+    Slot m_slots[MAX_VIEWERS];
+    Viewer m_viewers[MAX_VIEWERS];
+    uint32_t m_viewer_count = 0;
+    uint32_t m_renders = 0;
+    uint32_t m_shared = 0;
+
+    static void own_deleted_cb(lv_event_t* e) {
+        static_cast<LottieAsset*>(lv_event_get_user_data(e))->m_obj = nullptr;
+    }
+
+    static void viewer_deleted_cb(lv_event_t* e) {
+        static_cast<LottieAsset*>(lv_event_get_user_data(e))->remove_viewer(lv_event_get_current_target_obj(e));
+    }
+
+    [[nodiscard]] static LottieAsset* find(lv_obj_t* viewer) noexcept {
+        const uint32_t n = lv_obj_get_event_count(viewer);
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_event_dsc_t* dsc = lv_obj_get_event_dsc(viewer, i);
+            if (lv_event_dsc_get_cb(dsc) == &viewer_deleted_cb) {
+                return static_cast<LottieAsset*>(lv_event_dsc_get_user_data(dsc));
+            }
+        }
+        return nullptr;
+    }
+
+    static void exec_cb(void* var, int32_t v) {
+        auto* obj = static_cast<lv_obj_t*>(var);
+        LottieAsset* self = find(obj);
+        if (!self || !lv_obj_is_visible(obj)) return;
+        for (uint32_t i = 0; i < self->m_viewer_count; ++i) {
+            if (self->m_viewers[i].obj == obj) {
+                self->show(self->m_viewers[i], v);
+                return;
+            }
+        }
+    }
+
+    void release(Viewer& viewer) noexcept {
+        if (viewer.slot >= 0) --m_slots[viewer.slot].refs;
+        viewer.slot = -1;
+    }
+
+    /// Point a viewer at a buffer holding frame v
+    void show(Viewer& viewer, int32_t v) noexcept {
+        if (!m_obj) return;
+
+        // Pre-rendered ring
+        const detail::LottieFrameCache* c = detail::lottie_cache_find(m_obj);
+        if (c && c->ready == c->count) {
+            release(viewer);
+            lv_draw_buf_t* buf = c->frames[LV_CLAMP(0, v - c->first, static_cast<int32_t>(c->count) - 1)];
+            if (lv_image_get_src(viewer.obj) != buf) lv_image_set_src(viewer.obj, buf);
+            return;
+        }
+
+        // Another viewer already shows this frame
+        for (uint32_t i = 0; i < MAX_VIEWERS; ++i) {
+            Slot& s = m_slots[i];
+            if (s.refs == 0 || s.frame != v) continue;
+            if (viewer.slot != static_cast<int8_t>(i)) {
+                release(viewer);
+                viewer.slot = static_cast<int8_t>(i);
+                ++s.refs;
+                lv_image_set_src(viewer.obj, s.buf);
+                ++m_shared;
+            }
+            return;
+        }
+
+        // Re-render our own buffer if nobody else shows it, else take a free one
+        // (there is one: slots >= viewers, and ours is shared)
+        bool in_place = viewer.slot >= 0 && m_slots[viewer.slot].refs == 1;
+        if (!in_place) {
+            release(viewer);
+            for (uint32_t i = 0; i < MAX_VIEWERS && viewer.slot < 0; ++i) {
+                if (m_slots[i].refs == 0) viewer.slot = static_cast<int8_t>(i);
+            }
+            if (viewer.slot < 0) return;
+            ++m_slots[viewer.slot].refs;
+        }
+        Slot& s = m_slots[viewer.slot];
+        if (!s.buf) {
+            s.buf = lv_draw_buf_create(m_own->header.w, m_own->header.h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+            if (!s.buf) {
+                LV_LOG_WARN("LottieAsset: out of memory for a frame buffer");
+                release(viewer);
+                return;
+            }
+            if (lv_draw_buf_has_flag(m_own, LV_IMAGE_FLAGS_PREMULTIPLIED)) {
+                lv_draw_buf_set_flag(s.buf, LV_IMAGE_FLAGS_PREMULTIPLIED);
+            }
+        }
+        detail::lottie_render(reinterpret_cast<lv_lottie_t*>(m_obj), s.buf, v);
+        s.frame = v;
+        ++m_renders;
+        if (in_place) lv_image_cache_drop(s.buf);
+        lv_image_set_src(viewer.obj, s.buf);
+    }
+
+    void remove_viewer(lv_obj_t* obj) noexcept {
+        for (uint32_t i = 0; i < m_viewer_count; ++i) {
+            if (m_viewers[i].obj != obj) continue;
+            release(m_viewers[i]);
+            m_viewers[i] = m_viewers[--m_viewer_count];
+            m_viewers[m_viewer_count] = {};
+            return;
+        }
+    }
+
+    bool init(int32_t w, int32_t h, lv_display_t* display) noexcept {
+        if (!display) display = lv_display_get_default();
+        if (!display) return false;
+        m_own = lv_draw_buf_create(static_cast<uint32_t>(w), static_cast<uint32_t>(h),
+                                   LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+        if (!m_own) {
+            LV_LOG_WARN("LottieAsset: out of memory");
+            return false;
+        }
+        m_obj = lv_lottie_create(lv_display_get_layer_sys(display));
+        lv_obj_add_flag(m_obj, LV_OBJ_FLAG_HIDDEN);
+        lv_lottie_set_draw_buf(m_obj, m_own);
+        lv_obj_add_event_cb(m_obj, &own_deleted_cb, LV_EVENT_DELETE, this);
+        return true;
+    }
+
+    /// The hidden widget only holds the scene: it doesn't play
+    void pause_own() noexcept {
+        if (!m_obj) return;
+        if (lv_anim_t* anim = lv_lottie_get_anim(m_obj)) lv_anim_pause(anim);
+    }
+
+public:
+    /**
+     * @brief Parse an animation from embedded JSON data
+     *
+     * @param data Lottie JSON (must stay valid)
+     * @param size Size of the data in bytes
+     * @param w Render width
+     * @param h Render height
+     * @param display Display whose system layer holds the hidden scene (nullptr = default)
+     */
+    LottieAsset(const void* data, size_t size, int32_t w, int32_t h, lv_display_t* display = nullptr) noexcept {
+        if (init(w, h, display)) lv_lottie_set_src_data(m_obj, data, size);
+        pause_own();
+    }
+
+    /**
+     * @brief Parse an animation from a JSON file
+     *
+     * @param path Path to the JSON file (direct file access, as src_file())
+     * @param w Render width
+     * @param h Render height
+     * @param display Display whose system layer holds the hidden scene (nullptr = default)
+     */
+    LottieAsset(const char* path, int32_t w, int32_t h, lv_display_t* display = nullptr) noexcept {
+        if (init(w, h, display)) lv_lottie_set_src_file(m_obj, path);
+        pause_own();
+    }
+
+    ~LottieAsset() {
+        while (m_viewer_count > 0) detach(m_viewers[0].obj);
+        for (Slot& s : m_slots) {
+            if (!s.buf) continue;
+            lv_image_cache_drop(s.buf);
+            lv_draw_buf_destroy(s.buf);
+        }
+        if (m_obj) {
+            lv_obj_remove_event_cb_with_user_data(m_obj, &own_deleted_cb, this);
+            lv_obj_delete(m_obj);
+        }
+        if (m_own) lv_draw_buf_destroy(m_own);
+    }
+
+    LottieAsset(const LottieAsset&) = delete;
+    LottieAsset& operator=(const LottieAsset&) = delete;
+
+    /// Check if the scene was created
+    [[nodiscard]] bool valid() const noexcept { return m_obj != nullptr; }
+
+    /**
+     * @brief Show this animation in a Lottie widget
+     *
+     * The widget's animation gets this animation's frame range and
+     * duration; its own buffer and source are not used.
+     */
+    LottieAsset& attach(lv_obj_t* lottie) noexcept {
+        if (!m_obj || !lottie) return *this;
+        if (LottieAsset* other = find(lottie)) other->detach(lottie);
+        if (m_viewer_count == MAX_VIEWERS) {
+            LV_LOG_WARN("LottieAsset: more than %u widgets", static_cast<unsigned>(MAX_VIEWERS));
+            return *this;
+        }
+        lv_anim_t* src = lv_lottie_get_anim(m_obj);
+        lv_anim_t* anim = lv_lottie_get_anim(lottie);
+        if (!src || !anim) return *this;
+
+        m_viewers[m_viewer_count++] = {lottie, -1};
+        lv_obj_add_event_cb(lottie, &viewer_deleted_cb, LV_EVENT_DELETE, this);
+        lv_anim_set_values(anim, src->start_value, src->end_value);
+        lv_anim_set_duration(anim, src->duration);
+        lv_anim_set_exec_cb(anim, &exec_cb);
+        exec_cb(lottie, anim->current_value);
+        return *this;
+    }
+
+    /// Stop showing this animation in a widget (it goes blank)
+    LottieAsset& detach(lv_obj_t* lottie) noexcept {
+        if (find(lottie) != this) return *this;
+        lv_obj_remove_event_cb_with_user_data(lottie, &viewer_deleted_cb, this);
+        remove_viewer(lottie);
+        if (lv_anim_t* anim = lv_lottie_get_anim(lottie)) lv_anim_set_exec_cb(anim, nullptr);
+        lv_image_set_src(lottie, nullptr);
+        return *this;
+    }
+
+    /**
+     * @brief Pre-render every frame once for all widgets
+     *
+     * Same as Lottie::cache_frames(), with the frames shared by every
+     * attached widget.
+     */
+    LottieAsset& cache_frames(uint32_t budget, bool background = false) noexcept {
+        if (m_obj) Lottie(wrap, m_obj).cache_frames(budget, background);
+        return *this;
+    }
+
+    /// Check if widgets are served from pre-rendered frames
+    [[nodiscard]] bool frames_cached() const noexcept {
+        return m_obj && Lottie(wrap, m_obj).frames_cached();
+    }
+
+    /// Attached widgets
+    [[nodiscard]] uint32_t viewers() const noexcept { return m_viewer_count; }
+
+    /// Frames rasterized for widgets (without the pre-rendered ring)
+    [[nodiscard]] uint32_t renders() const noexcept { return m_renders; }
+
+    /// Times a widget was given a frame another widget already had
+    [[nodiscard]] uint32_t shared() const noexcept { return m_shared; }
 };
 
+inline Lottie& Lottie::asset(LottieAsset& asset) noexcept {
+    asset.attach(m_obj);
+    return *this;
+}
+
 } // namespace lv
 
 #endif // LV_USE_LOTTIE
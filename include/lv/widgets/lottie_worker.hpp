@@ -0,0 +1,587 @@
+#pragma once
+
+/**
+ * @file lottie_worker.hpp
+ * @brief Rasterize Lottie animations and vector drawings on a worker thread, one frame ahead
+ *
+ * An lv_lottie rasterizes each frame with ThorVG inside its animation
+ * callback, on the LVGL thread, before the frame can be composited; a
+ * vector drawing is rasterized inside the render pass. LottieWorker moves
+ * that work to its own thread and pipelines it: while LVGL composites
+ * frame N from one buffer, the worker rasterizes frame N+1 into the other.
+ * Finished buffers are handed back through a lock-free state slot per
+ * widget; if the worker is late, the widget keeps showing its current
+ * frame instead of stalling the UI.
+ *
+ * @code
+ *   lv::LottieWorker worker;                          // One thread for all its jobs
+ *   auto anim = lv::Lottie::create(parent).loop();
+ *   worker.add(anim, animation_json, sizeof(animation_json), 128, 128);
+ *
+ *   // Vector drawing shown in an image: built from a value on the worker thread
+ *   worker.add_vector(gauge_img, 200, 200, [](lv::VectorFrame& f, int32_t angle, void* ud) {
+ *       const auto* g = static_cast<const Gauge*>(ud);   // Paths built once, never changed
+ *       f.fill(g->face.get(), g->identity, lv_color32_make(40, 40, 40, 255));
+ *       f.stroke(g->needle.get(), g->rotation(angle), lv_color32_make(255, 0, 0, 255), 4);
+ *   }, &gauge);
+ *   worker.request(gauge_img, 45);                    // Rendered off-thread, shown when ready
+ *   // ...
+ *   worker.log();   // Rendered, shown and late frames
+ * @endcode
+ *
+ * ThorVG can be used from several threads as long as each canvas and
+ * animation is only used by one thread at a time; LVGL's software draw
+ * units rely on that too when they rasterize vector tasks in parallel. The
+ * worker creates a private Tvg_Canvas (and Tvg_Animation) per job and
+ * never touches the widgets' own ThorVG objects or any LVGL state.
+ *
+ * Lottie jobs parse the JSON on the worker and own the ThorVG scene; the
+ * widget needs no buffer or source of its own. Playback controls (pause,
+ * duration, repeat) stay on the widget's lv_anim. Vector jobs call a draw
+ * function on the worker with the value passed to request(); it may only
+ * read data the LVGL thread doesn't change while the job is attached.
+ */
+
+#include <lvgl.h>
+
+#if LV_USE_LOTTIE
+
+#include "lottie.hpp"
+#include <src/draw/lv_draw_vector_private.h>   // Path ops and points
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <semaphore>
+#include <thread>
+
+namespace lv {
+
+/**
+ * @brief One frame of a vector job, built on the worker thread
+ *
+ * Converts LVGL vector paths into shapes of the job's private ThorVG
+ * canvas. Only ThorVG is called: the paths are read, never changed.
+ */
+class VectorFrame {
+    Tvg_Canvas* m_canvas;
+
+    [[nodiscard]] Tvg_Paint* shape(const lv_vector_path_t* path, const lv_matrix_t& m) noexcept {
+        Tvg_Paint* s = tvg_shape_new();
+        const uint32_t n_ops = lv_array_size(&path->ops);
+        const auto* pts = lv_array_size(&path->points)
+                              ? static_cast<const lv_fpoint_t*>(lv_array_at(&path->points, 0))
+                              : nullptr;
+        lv_fpoint_t cur{0, 0};
+        uint32_t pi = 0;
+        for (uint32_t i = 0; i < n_ops; ++i) {
+            switch (*static_cast<const lv_vector_path_op_t*>(lv_array_at(&path->ops, i))) {
+            case LV_VECTOR_PATH_OP_MOVE_TO:
+                cur = pts[pi++];
+                tvg_shape_move_to(s, cur.x, cur.y);
+                break;
+            case LV_VECTOR_PATH_OP_LINE_TO:
+                cur = pts[pi++];
+                tvg_shape_line_to(s, cur.x, cur.y);
+                break;
+            case LV_VECTOR_PATH_OP_QUAD_TO: {
+                // As a cubic: control points 2/3 of the way to the quad's one
+                const lv_fpoint_t c = pts[pi];
+                const lv_fpoint_t e = pts[pi + 1];
+                pi += 2;
+                tvg_shape_cubic_to(s, cur.x + (c.x - cur.x) * 2.0f / 3.0f, cur.y + (c.y - cur.y) * 2.0f / 3.0f,
+                                   e.x + (c.x - e.x) * 2.0f / 3.0f, e.y + (c.y - e.y) * 2.0f / 3.0f, e.x, e.y);
+                cur = e;
+                break;
+            }
+            case LV_VECTOR_PATH_OP_CUBIC_TO:
+                tvg_shape_cubic_to(s, pts[pi].x, pts[pi].y, pts[pi + 1].x, pts[pi + 1].y,
+                                   pts[pi + 2].x, pts[pi + 2].y);
+                cur = pts[pi + 2];
+                pi += 3;
+                break;
+            case LV_VECTOR_PATH_OP_CLOSE:
+                tvg_shape_close(s);
+                break;
+            }
+        }
+        const Tvg_Matrix tm = {m.m[0][0], m.m[0][1], m.m[0][2],
+                               m.m[1][0], m.m[1][1], m.m[1][2],
+                               m.m[2][0], m.m[2][1], m.m[2][2]};
+        tvg_paint_set_transform(s, &tm);
+        return s;
+    }
+
+public:
+    explicit VectorFrame(Tvg_Canvas* canvas) noexcept : m_canvas(canvas) {}
+
+    /// Fill a path (non-zero rule)
+    VectorFrame& fill(const lv_vector_path_t* path, const lv_matrix_t& m, lv_color32_t color) noexcept {
+        Tvg_Paint* s = shape(path, m);
+        tvg_shape_set_fill_color(s, color.red, color.green, color.blue, color.alpha);
+        tvg_canvas_push(m_canvas, s);
+        return *this;
+    }
+
+    /// Stroke a path with round joins and caps
+    VectorFrame& stroke(const lv_vector_path_t* path, const lv_matrix_t& m, lv_color32_t color,
+                        float width) noexcept {
+        Tvg_Paint* s = shape(path, m);
+        tvg_shape_set_stroke_width(s, width);
+        tvg_shape_set_stroke_color(s, color.red, color.green, color.blue, color.alpha);
+        tvg_shape_set_stroke_join(s, TVG_STROKE_JOIN_ROUND);
+        tvg_shape_set_stroke_cap(s, TVG_STROKE_CAP_ROUND);
+        tvg_canvas_push(m_canvas, s);
+        return *this;
+    }
+
+    /// The job's canvas, to push other ThorVG paints
+    [[nodiscard]] Tvg_Canvas* canvas() noexcept { return m_canvas; }
+};
+
+/// Builds a vector job's frame on the worker thread (no LVGL calls)
+using VectorDrawFn = void (*)(VectorFrame& frame, int32_t value, void* user_data);
+
+/**
+ * @brief Worker thread that rasterizes Lottie widgets and vector images a frame ahead
+ *
+ * Non-movable (widgets keep a pointer to their slot). Widgets still
+ * attached when it is destroyed go blank.
+ */
+class LottieWorker {
+public:
+    /// Widgets per worker
+    static constexpr uint32_t MAX_JOBS = 8;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Slot states; the thread that moves a slot out of a state owns it meanwhile
+    enum : uint8_t {
+        FREE,        ///< Unused (worker: scene released)
+        LOAD,        ///< LVGL -> worker: parse, then render frame 0
+        RENDERING,   ///< Worker owns the back buffer
+        READY,       ///< Worker -> LVGL: back buffer holds `done`
+        IDLE,        ///< LVGL owns both buffers
+        REQUESTED,   ///< LVGL -> worker: render `want`
+        FAILED,      ///< Source didn't parse
+        CLOSED,      ///< LVGL -> worker: release the scene
+    };
+
+    struct Job {
+        std::atomic<uint8_t> state{FREE};
+        LottieWorker* owner = nullptr;
+
+        // Set by LVGL before LOAD/REQUESTED, read-only afterwards
+        lv_obj_t* obj = nullptr;
+        const void* data = nullptr;
+        size_t size = 0;
+        VectorDrawFn draw = nullptr;   ///< nullptr = Lottie job
+        void* user_data = nullptr;
+        lv_draw_buf_t* bufs[2] = {};
+
+        // LVGL thread only
+        uint8_t front = 0;
+        bool started = false;
+        bool has_pending = false;      ///< Vector: value to render once the slot is IDLE
+        int32_t pending = 0;
+        int32_t last_v = 0;
+        lv_anim_exec_xcb_t saved_exec = nullptr;
+
+        // Handed over with the state: want to the worker, the rest back to LVGL
+        int32_t want = 0;
+        int32_t done = 0;
+        int32_t frames = 0;
+        uint32_t duration_ms = 0;
+
+        // Worker thread only
+        Tvg_Canvas* canvas = nullptr;
+        Tvg_Animation* anim = nullptr;
+    };
+
+    Job m_jobs[MAX_JOBS];
+    std::counting_semaphore<> m_sem{0};
+    std::atomic<bool> m_stop{false};
+    std::thread m_thread;
+    lv_timer_t* m_timer = nullptr;   ///< Picks up finished vector frames
+
+    std::atomic<uint32_t> m_rendered{0};
+    std::atomic<uint64_t> m_render_us{0};
+    uint32_t m_shown = 0;
+    uint32_t m_late = 0;
+
+    // ==================== LVGL thread ====================
+
+    static void deleted_cb(lv_event_t* e) {
+        auto* job = static_cast<Job*>(lv_event_get_user_data(e));
+        job->owner->close(*job, true);
+    }
+
+    [[nodiscard]] static Job* find(lv_obj_t* obj) noexcept {
+        const uint32_t n = lv_obj_get_event_count(obj);
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_event_dsc_t* dsc = lv_obj_get_event_dsc(obj, i);
+            if (lv_event_dsc_get_cb(dsc) == &deleted_cb) return static_cast<Job*>(lv_event_dsc_get_user_data(dsc));
+        }
+        return nullptr;
+    }
+
+    static void exec_cb(void* var, int32_t v) {
+        auto* obj = static_cast<lv_obj_t*>(var);
+        if (Job* job = find(obj)) job->owner->step(*job, v);
+    }
+
+    /// Swap the finished back buffer in
+    void show(Job& job) noexcept {
+        job.front ^= 1;
+        lv_draw_buf_t* buf = job.bufs[job.front];
+        lv_image_cache_drop(buf);
+        lv_image_set_src(job.obj, buf);
+        ++m_shown;
+    }
+
+    /// Lottie: show a finished frame and ask for the next one
+    void step(Job& job, int32_t v) noexcept {
+        uint8_t state = job.state.load(std::memory_order_acquire);
+        if (state == FAILED) return;
+        if (state == READY) {
+            show(job);
+            if (!job.started) {
+                // Frame range and duration known once the worker parsed the source
+                job.started = true;
+                lv_anim_t* anim = lv_lottie_get_anim(job.obj);
+                lv_anim_set_values(anim, 0, LV_MAX(job.frames - 1, 0));
+                lv_anim_set_duration(anim, job.duration_ms);
+                v = 0;
+            }
+            state = IDLE;
+        }
+        if (state != IDLE) {
+            if (state != LOAD) ++m_late;   // Worker still on the previous frame
+            job.last_v = v;
+            return;
+        }
+        if (!lv_obj_is_visible(job.obj)) {
+            job.state.store(IDLE, std::memory_order_relaxed);
+            return;
+        }
+
+        // Predict the next animation value from the last step, wrapping at the end
+        const int32_t delta = v - job.last_v;
+        int32_t next = v + (delta > 0 ? delta : 1);
+        if (next >= job.frames) next = job.frames > 0 ? next % job.frames : 0;
+        job.last_v = v;
+        submit(job, next);
+    }
+
+    void submit(Job& job, int32_t value) noexcept {
+        job.want = value;
+        job.state.store(REQUESTED, std::memory_order_release);
+        m_sem.release();
+    }
+
+    static void timer_cb(lv_timer_t* t) {
+        static_cast<LottieWorker*>(lv_timer_get_user_data(t))->pick_up();
+    }
+
+    /// Vector: show finished frames, hand over pending values; pause when nothing is in flight
+    void pick_up() noexcept {
+        bool busy = false;
+        for (Job& job : m_jobs) {
+            if (!job.obj || !job.draw) continue;
+            uint8_t state = job.state.load(std::memory_order_acquire);
+            if (state == READY) {
+                show(job);
+                state = IDLE;
+                job.state.store(IDLE, std::memory_order_relaxed);
+            }
+            if (state == IDLE && job.has_pending) {
+                job.has_pending = false;
+                submit(job, job.pending);
+                state = REQUESTED;
+            }
+            busy |= state == REQUESTED || state == RENDERING;
+        }
+        if (!busy) lv_timer_pause(m_timer);
+    }
+
+    /// Take a slot back from the worker; it releases the scene on its thread
+    void close(Job& job, bool deleting) noexcept {
+        for (;;) {
+            uint8_t state = job.state.load(std::memory_order_acquire);
+            if (state == RENDERING || state == LOAD) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (job.state.compare_exchange_weak(state, CLOSED, std::memory_order_acq_rel)) break;
+        }
+        if (!deleting) {
+            lv_obj_remove_event_cb_with_user_data(job.obj, &deleted_cb, &job);
+            if (!job.draw) {
+                if (lv_anim_t* anim = lv_lottie_get_anim(job.obj)) lv_anim_set_exec_cb(anim, job.saved_exec);
+            }
+            lv_image_set_src(job.obj, nullptr);
+        }
+        for (lv_draw_buf_t*& b : job.bufs) {
+            if (!b) continue;
+            lv_image_cache_drop(b);
+            lv_draw_buf_destroy(b);
+            b = nullptr;
+        }
+        job.obj = nullptr;
+        m_sem.release();
+    }
+
+    /// Take a free slot and give it two ARGB8888 buffers
+    [[nodiscard]] Job* claim(lv_obj_t* obj, int32_t w, int32_t h) noexcept {
+        Job* job = nullptr;
+        for (Job& j : m_jobs) {
+            if (j.state.load(std::memory_order_acquire) == FREE) {
+                job = &j;
+                break;
+            }
+        }
+        if (!job) {
+            LV_LOG_WARN("LottieWorker: more than %u widgets", static_cast<unsigned>(MAX_JOBS));
+            return nullptr;
+        }
+        for (lv_draw_buf_t*& b : job->bufs) {
+            b = lv_draw_buf_create(static_cast<uint32_t>(w), static_cast<uint32_t>(h),
+                                   LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+            if (!b) {
+                LV_LOG_WARN("LottieWorker: out of memory");
+                for (lv_draw_buf_t*& f : job->bufs) {
+                    if (f) lv_draw_buf_destroy(f);
+                    f = nullptr;
+                }
+                return nullptr;
+            }
+            lv_draw_buf_set_flag(b, LV_IMAGE_FLAGS_PREMULTIPLIED);
+        }
+        job->owner = this;
+        job->obj = obj;
+        job->front = 0;
+        job->started = false;
+        job->has_pending = false;
+        job->last_v = 0;
+        lv_obj_add_event_cb(obj, &deleted_cb, LV_EVENT_DELETE, job);
+        return job;
+    }
+
+    // ==================== Worker thread ====================
+
+    static void target(Job& job) noexcept {
+        lv_draw_buf_t* buf = job.bufs[job.front ^ 1];
+        std::memset(buf->data, 0, static_cast<size_t>(buf->header.stride) * buf->header.h);
+        tvg_swcanvas_set_target(job.canvas, reinterpret_cast<uint32_t*>(buf->data), buf->header.stride / 4,
+                                buf->header.w, buf->header.h, TVG_COLORSPACE_ARGB8888);
+    }
+
+    static void render(Job& job, int32_t frame) noexcept {
+        target(job);
+        if (job.draw) {
+            tvg_canvas_clear(job.canvas, true);
+            VectorFrame f(job.canvas);
+            job.draw(f, frame, job.user_data);
+        } else {
+            tvg_animation_set_frame(job.anim, static_cast<float>(frame));
+        }
+        tvg_canvas_update(job.canvas);
+        tvg_canvas_draw(job.canvas);
+        tvg_canvas_sync(job.canvas);
+        job.done = frame;
+    }
+
+    static bool load(Job& job) noexcept {
+        job.canvas = tvg_swcanvas_create();
+        if (job.draw) return job.canvas != nullptr;
+        job.anim = tvg_animation_new();
+        Tvg_Paint* picture = tvg_animation_get_picture(job.anim);
+        // Copied: ThorVG's loader cache could otherwise share one loader between pictures
+        if (tvg_picture_load_data(picture, static_cast<const char*>(job.data), static_cast<uint32_t>(job.size),
+                                  "lottie", true) != TVG_RESULT_SUCCESS) {
+            return false;
+        }
+        tvg_picture_set_size(picture, static_cast<float>(job.bufs[0]->header.w),
+                             static_cast<float>(job.bufs[0]->header.h));
+        tvg_canvas_push(job.canvas, picture);
+        float frames = 0;
+        float duration = 0;
+        tvg_animation_get_total_frame(job.anim, &frames);
+        tvg_animation_get_duration(job.anim, &duration);
+        job.frames = static_cast<int32_t>(frames);
+        job.duration_ms = static_cast<uint32_t>(duration * 1000.0f);
+        return true;
+    }
+
+    static void release(Job& job) noexcept {
+        if (job.anim) tvg_animation_del(job.anim);
+        if (job.canvas) tvg_canvas_destroy(job.canvas);
+        job.anim = nullptr;
+        job.canvas = nullptr;
+    }
+
+    void run() noexcept {
+        for (;;) {
+            m_sem.acquire();
+            for (Job& job : m_jobs) {
+                uint8_t state = job.state.load(std::memory_order_acquire);
+                if (state == CLOSED) {
+                    release(job);
+                    job.state.store(FREE, std::memory_order_release);
+                    continue;
+                }
+                if (state != LOAD && state != REQUESTED) continue;
+
+                const Clock::time_point t0 = Clock::now();
+                if (state == LOAD) {
+                    // LOAD is only left by the worker
+                    if (!load(job)) {
+                        LV_LOG_WARN("LottieWorker: can't parse the animation");
+                        job.state.store(FAILED, std::memory_order_release);
+                        continue;
+                    }
+                    render(job, 0);
+                } else {
+                    if (!job.state.compare_exchange_strong(state, RENDERING, std::memory_order_acq_rel)) continue;
+                    if (!job.canvas && !load(job)) {
+                        job.state.store(FAILED, std::memory_order_release);
+                        continue;
+                    }
+                    render(job, job.want);
+                }
+                m_render_us.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                          Clock::now() - t0).count()), std::memory_order_relaxed);
+                m_rendered.fetch_add(1, std::memory_order_relaxed);
+                job.state.store(READY, std::memory_order_release);
+            }
+            if (m_stop.load(std::memory_order_acquire)) break;
+        }
+        for (Job& job : m_jobs) release(job);
+    }
+
+public:
+    /// Start the worker thread
+    LottieWorker() {
+        m_timer = lv_timer_create(&timer_cb, LV_DEF_REFR_PERIOD, this);
+        lv_timer_pause(m_timer);
+        m_thread = std::thread([this] { run(); });
+    }
+
+    /// Detach all widgets and join the thread
+    ~LottieWorker() {
+        for (Job& job : m_jobs) {
+            if (job.obj) close(job, false);
+        }
+        m_stop.store(true, std::memory_order_release);
+        m_sem.release();
+        if (m_thread.joinable()) m_thread.join();
+        lv_timer_delete(m_timer);
+    }
+
+    LottieWorker(const LottieWorker&) = delete;
+    LottieWorker& operator=(const LottieWorker&) = delete;
+
+    /**
+     * @brief Play an animation in a Lottie widget, rasterized by the worker
+     *
+     * @param lottie Widget to show it in (its own buffer and source are not used)
+     * @param data Lottie JSON (copied by ThorVG when parsed; must stay valid until then)
+     * @param size Size of the data in bytes
+     * @param w Render width
+     * @param h Render height
+     * @return false if all slots are taken or out of memory
+     */
+    bool add(Lottie lottie, const void* data, size_t size, int32_t w, int32_t h) noexcept {
+        lv_obj_t* obj = lottie.get();
+        lv_anim_t* anim = obj ? lv_lottie_get_anim(obj) : nullptr;
+        if (!anim) return false;
+        remove(obj);
+
+        Job* job = claim(obj, w, h);
+        if (!job) return false;
+        job->data = data;
+        job->size = size;
+        job->draw = nullptr;
+        job->saved_exec = anim->exec_cb;
+        lv_anim_set_exec_cb(anim, &exec_cb);
+        job->state.store(LOAD, std::memory_order_release);
+        m_sem.release();
+        return true;
+    }
+
+    /**
+     * @brief Show a vector drawing in an image, rasterized by the worker
+     *
+     * Nothing is drawn until request() passes a first value.
+     *
+     * @param image lv_image to show it in
+     * @param w Render width
+     * @param h Render height
+     * @param draw Builds a frame on the worker thread (no LVGL calls)
+     * @param user_data Passed to draw; must not change while attached
+     * @return false if all slots are taken or out of memory
+     */
+    bool add_vector(lv_obj_t* image, int32_t w, int32_t h, VectorDrawFn draw, void* user_data = nullptr) noexcept {
+        if (!image || !draw) return false;
+        remove(image);
+
+        Job* job = claim(image, w, h);
+        if (!job) return false;
+        job->data = nullptr;
+        job->size = 0;
+        job->draw = draw;
+        job->user_data = user_data;
+        job->state.store(IDLE, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Render a vector job for a new value
+     *
+     * Handed to the worker at once if it is idle, else when the frame in
+     * flight was picked up; only the latest value is kept.
+     */
+    LottieWorker& request(lv_obj_t* image, int32_t value) noexcept {
+        Job* job = image ? find(image) : nullptr;
+        if (!job || job->owner != this || !job->draw) return *this;
+        if (job->has_pending) ++m_late;   // Replaces a value that was never rendered
+        job->pending = value;
+        job->has_pending = true;
+        lv_timer_resume(m_timer);
+        pick_up();
+        return *this;
+    }
+
+    /// Stop rasterizing for a widget (it goes blank)
+    LottieWorker& remove(lv_obj_t* obj) noexcept {
+        Job* job = obj ? find(obj) : nullptr;
+        if (job && job->owner == this) close(*job, false);
+        return *this;
+    }
+
+    LottieWorker& remove(Lottie lottie) noexcept {
+        return remove(lottie.get());
+    }
+
+    /// Frames rasterized by the worker
+    [[nodiscard]] uint32_t rendered() const noexcept { return m_rendered.load(std::memory_order_relaxed); }
+
+    /// Frames handed to widgets
+    [[nodiscard]] uint32_t shown() const noexcept { return m_shown; }
+
+    /// Animation steps where the next frame wasn't ready, or vector values dropped for newer ones
+    [[nodiscard]] uint32_t late() const noexcept { return m_late; }
+
+    /// Print statistics with LV_LOG_USER
+    void log() const noexcept {
+        [[maybe_unused]] const uint32_t n = rendered();
+        LV_LOG_USER("LottieWorker: rendered=%u shown=%u late=%u avg %uus/frame",
+                    static_cast<unsigned>(n), static_cast<unsigned>(m_shown), static_cast<unsigned>(m_late),
+                    static_cast<unsigned>(n ? m_render_us.load(std::memory_order_relaxed) / n : 0));
+    }
+};
+
+} // namespace lv
+
+#endif // LV_USE_LOTTIE
@@ -34,7 +34,12 @@
 /*=================
  * OPERATING SYSTEM
  *=================*/
-#define LV_USE_OS   LV_OS_NONE
+/* pthread OS layer: software rendering runs on LV_DRAW_SW_DRAW_UNIT_CNT threads
+ * (see lv::RenderThreads). Set LV_OS_NONE for single-threaded targets. */
+#define LV_USE_OS   LV_OS_PTHREAD
+
+/* Software draw units (render threads), one per core on quad-core targets */
+#define LV_DRAW_SW_DRAW_UNIT_CNT 4
 
 /*=====================
  * RENDERING CONFIG
@@ -161,6 +166,16 @@
 /* Native X11 driver - recommended for Linux desktop */
 #define LV_USE_X11 1
 
+/* LVGL's Linux framebuffer driver. lv::FBDisplay doesn't use it: it is enabled
+ * by LV_CPP_USE_FBDISPLAY (CMake option LV_WITH_FBDISPLAY). */
+#define LV_USE_LINUX_FBDEV 0
+
+/* Linux DRM/KMS - lv::DRMDisplay renders into page-flipped dumb buffers (needs libdrm).
+ * CMake defines it to 1 when libdrm is found (option LV_WITH_DRM). */
+#ifndef LV_USE_LINUX_DRM
+    #define LV_USE_LINUX_DRM 0
+#endif
+
 /* SDL driver - cross-platform simulator */
 #define LV_USE_SDL 0
 #if LV_USE_SDL
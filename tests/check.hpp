@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * @file check.hpp
+ * @brief Minimal assertion helpers for the unit tests
+ *
+ * Each test is a plain executable registered with CTest; a failed CHECK
+ * prints the location and makes main() return non-zero.
+ */
+
+#include <cstdio>
+
+namespace lv_test {
+
+inline int g_failures = 0;
+
+inline void fail(const char* file, int line, const char* expr) {
+    std::printf("%s:%d: CHECK failed: %s\n", file, line, expr);
+    ++g_failures;
+}
+
+/// Exit code for main()
+inline int result() {
+    if (g_failures) std::printf("%d check(s) failed\n", g_failures);
+    return g_failures ? 1 : 0;
+}
+
+} // namespace lv_test
+
+#define CHECK(expr) ((expr) ? (void)0 : lv_test::fail(__FILE__, __LINE__, #expr))
+#define CHECK_POINT(p, px, py) CHECK((p).x == (px) && (p).y == (py))
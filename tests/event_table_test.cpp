@@ -0,0 +1,95 @@
+/**
+ * @file event_table_test.cpp
+ * @brief EventTable dispatch, including handlers that delete their own object
+ */
+
+#include <lv/core/event_table.hpp>
+#include "check.hpp"
+
+namespace {
+
+struct Calls {
+    int clicked = 0;
+    int after = 0;
+    int deleted = 0;
+    int pressed = 0;
+};
+
+void count_clicked(lv_event_t*, void* ud) { ++static_cast<Calls*>(ud)->clicked; }
+void count_after(lv_event_t*, void* ud) { ++static_cast<Calls*>(ud)->after; }
+void count_deleted(lv_event_t*, void* ud) { ++static_cast<Calls*>(ud)->deleted; }
+void count_pressed(lv_event_t*, void* ud) { ++static_cast<Calls*>(ud)->pressed; }
+
+void delete_target(lv_event_t* e, void* ud) {
+    ++static_cast<Calls*>(ud)->clicked;
+    lv_obj_delete(lv_event_get_current_target_obj(e));
+}
+
+void send_pressed(lv_event_t* e, void*) {
+    lv_obj_send_event(lv_event_get_current_target_obj(e), LV_EVENT_PRESSED, nullptr);
+}
+
+} // namespace
+
+static void test_dispatch() {
+    lv_obj_t* obj = lv_obj_create(lv_screen_active());
+    Calls calls;
+    lv::EventTable* table = lv::EventTable::of(obj);
+    CHECK(table && lv::EventTable::of(obj) == table);
+    table->add(LV_EVENT_CLICKED, &count_clicked, &calls);
+    table->add(LV_EVENT_CLICKED, &count_after, &calls);
+    table->add(LV_EVENT_PRESSED, &count_pressed, &calls);
+    CHECK(table->size() == 3);
+
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, nullptr);
+    CHECK(calls.clicked == 1 && calls.after == 1 && calls.pressed == 0);
+
+    CHECK(table->remove(LV_EVENT_CLICKED, &count_after, &calls) == 1);
+    CHECK(!table->has(LV_EVENT_RELEASED));
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, nullptr);
+    CHECK(calls.clicked == 2 && calls.after == 1);
+    lv_obj_delete(obj);
+}
+
+static void test_nested() {
+    // A handler that sends another event to its own object
+    lv_obj_t* obj = lv_obj_create(lv_screen_active());
+    Calls calls;
+    lv::EventTable* table = lv::EventTable::of(obj);
+    table->add(LV_EVENT_CLICKED, &send_pressed, nullptr);
+    table->add(LV_EVENT_CLICKED, &count_clicked, &calls);
+    table->add(LV_EVENT_PRESSED, &count_pressed, &calls);
+
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, nullptr);
+    CHECK(calls.pressed == 1 && calls.clicked == 1);
+    lv_obj_delete(obj);
+}
+
+static void test_delete_from_handler() {
+    lv_obj_t* obj = lv_obj_create(lv_screen_active());
+    Calls calls;
+    lv::EventTable* table = lv::EventTable::of(obj);
+    table->add(LV_EVENT_CLICKED, &delete_target, &calls);
+    table->add(LV_EVENT_CLICKED, &count_after, &calls);   // Must not run: the object is gone
+    table->add(LV_EVENT_DELETE, &count_deleted, &calls);
+
+    const lv_result_t res = lv_obj_send_event(obj, LV_EVENT_CLICKED, nullptr);
+    CHECK(res == LV_RESULT_INVALID);
+    CHECK(calls.clicked == 1);
+    CHECK(calls.deleted == 1);
+    CHECK(calls.after == 0);
+    CHECK(lv_obj_get_child_count(lv_screen_active()) == 0);
+}
+
+int main() {
+    lv_init();
+    lv_display_t* disp = lv_display_create(64, 64);
+
+    test_dispatch();
+    test_nested();
+    test_delete_from_handler();
+
+    lv_display_delete(disp);
+    lv_deinit();
+    return lv_test::result();
+}
@@ -0,0 +1,92 @@
+/**
+ * @file flush_filter_test.cpp
+ * @brief FlushFilter's area hash and the record of what the panel shows
+ */
+
+#include <lv/core/flush_filter.hpp>
+#include "check.hpp"
+#include <cstring>
+
+using lv::detail::flush_hash;
+
+static void test_hash() {
+    uint8_t a[3 * 20];
+    for (uint32_t i = 0; i < sizeof(a); ++i) a[i] = static_cast<uint8_t>(i * 7);
+    uint8_t b[3 * 20];
+    std::memcpy(b, a, sizeof(a));
+
+    // 3 rows of 13 bytes (one 8-byte step and a 5-byte tail) in a 20-byte stride
+    const uint64_t h = flush_hash(a, 13, 20, 3, 1);
+    CHECK(flush_hash(b, 13, 20, 3, 1) == h);
+
+    // Padding between rows is not hashed
+    b[15] ^= 0xFF;
+    CHECK(flush_hash(b, 13, 20, 3, 1) == h);
+
+    // Every byte in the rows is: head, tail, last row
+    const uint32_t changed[] = {0, 7, 8, 12, 20, 45, 52};
+    for (uint32_t i : changed) {
+        std::memcpy(b, a, sizeof(a));
+        b[i] ^= 0x01;
+        CHECK(flush_hash(b, 13, 20, 3, 1) != h);
+    }
+
+    // The seed (area size) and the row count matter
+    CHECK(flush_hash(a, 13, 20, 3, 2) != h);
+    CHECK(flush_hash(a, 13, 20, 2, 1) != h);
+
+    // Swapped 8-byte words differ
+    uint8_t c[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    uint8_t d[16] = {9, 10, 11, 12, 13, 14, 15, 16, 1, 2, 3, 4, 5, 6, 7, 8};
+    CHECK(flush_hash(c, 16, 16, 1, 0) != flush_hash(d, 16, 16, 1, 0));
+}
+
+static void test_shown() {
+    lv::detail::ShownAreas<4> shown;
+    const lv_area_t a = {0, 0, 9, 9};
+    const lv_area_t b = {20, 0, 29, 9};
+    const lv_area_t ab = {5, 0, 24, 9};   // Overlaps a and b
+
+    CHECK(!shown.shows(a, 1));
+    shown.sent(a, 1);
+    shown.sent(b, 2);
+    CHECK(shown.shows(a, 1));
+    CHECK(!shown.shows(a, 2));   // Same area, new pixels
+    CHECK(shown.shows(b, 2));
+    CHECK(!shown.shows({0, 0, 9, 8}, 1));
+
+    // Resending an area replaces its hash
+    shown.sent(a, 3);
+    CHECK(shown.shows(a, 3));
+    CHECK(!shown.shows(a, 1));
+
+    // Sending an overlapping area forgets what was under it
+    shown.sent(ab, 4);
+    CHECK(!shown.shows(a, 3));
+    CHECK(!shown.shows(b, 2));
+    CHECK(shown.shows(ab, 4));
+
+    shown.clear();
+    CHECK(!shown.shows(ab, 4));
+}
+
+static void test_shown_lru() {
+    lv::detail::ShownAreas<4> shown;
+    for (int32_t i = 0; i < 4; ++i) shown.sent({i * 10, 0, i * 10 + 9, 9}, i);
+
+    // Touch area 0, so area 1 is the least recently used
+    CHECK(shown.shows({0, 0, 9, 9}, 0));
+    shown.sent({100, 0, 109, 9}, 9);
+    CHECK(shown.shows({0, 0, 9, 9}, 0));
+    CHECK(!shown.shows({10, 0, 19, 9}, 1));
+    CHECK(shown.shows({20, 0, 29, 9}, 2));
+    CHECK(shown.shows({30, 0, 39, 9}, 3));
+    CHECK(shown.shows({100, 0, 109, 9}, 9));
+}
+
+int main() {
+    test_hash();
+    test_shown();
+    test_shown_lru();
+    return lv_test::result();
+}
@@ -0,0 +1,125 @@
+/**
+ * @file refresh_policy_test.cpp
+ * @brief Tile-grid coalescing, overhead merging and rectangle cap of dirty areas
+ */
+
+#include <lv/core/refresh_policy.hpp>
+#include "check.hpp"
+#include <initializer_list>
+
+using Areas = lv::detail::DirtyAreas<8>;
+
+#define CHECK_AREA(a, ax1, ay1, ax2, ay2) \
+    CHECK((a).x1 == (ax1) && (a).y1 == (ay1) && (a).x2 == (ax2) && (a).y2 == (ay2))
+
+static Areas make(std::initializer_list<lv_area_t> list) {
+    Areas s;
+    for (const lv_area_t& a : list) s.push(a);
+    return s;
+}
+
+/// True if (x, y) lies in one of the areas
+static bool covered(const Areas& s, int32_t x, int32_t y) {
+    for (uint32_t i = 0; i < s.count; ++i) {
+        const lv_area_t& a = s.areas[i];
+        if (x >= a.x1 && x <= a.x2 && y >= a.y1 && y <= a.y2) return true;
+    }
+    return false;
+}
+
+static void test_tiles_snap() {
+    // One pixel snaps to its 16 x 16 tile
+    Areas s = make({{20, 40, 20, 40}});
+    s.coalesce_tiles(16, 16, 320, 240);
+    CHECK(s.count == 1);
+    CHECK_AREA(s.areas[0], 16, 32, 31, 47);
+}
+
+static void test_tiles_runs() {
+    // Two areas in neighbouring tiles of one row: one run
+    Areas s = make({{0, 0, 5, 5}, {20, 2, 25, 8}});
+    s.coalesce_tiles(16, 16, 320, 240);
+    CHECK(s.count == 1);
+    CHECK_AREA(s.areas[0], 0, 0, 31, 15);
+
+    // A 2 x 3 tile block grows downwards into one rectangle
+    s = make({{16, 16, 47, 20}, {16, 30, 47, 40}, {20, 48, 40, 63}});
+    s.coalesce_tiles(16, 16, 320, 240);
+    CHECK(s.count == 1);
+    CHECK_AREA(s.areas[0], 16, 16, 47, 63);
+
+    // Separate tiles stay separate
+    s = make({{0, 0, 1, 1}, {64, 0, 65, 1}, {0, 64, 1, 65}});
+    s.coalesce_tiles(16, 16, 320, 240);
+    CHECK(s.count == 3);
+}
+
+static void test_tiles_edges() {
+    // Tiles are clipped to the display
+    Areas s = make({{310, 230, 319, 239}});
+    s.coalesce_tiles(16, 16, 320, 240);
+    CHECK(s.count == 1);
+    CHECK_AREA(s.areas[0], 304, 224, 319, 239);
+
+    // A full-width row uses all 64 columns (countr_one == 64)
+    s = make({{0, 0, 639, 0}});
+    s.coalesce_tiles(1, 1, 640, 480);
+    CHECK(s.count == 1);
+    CHECK_AREA(s.areas[0], 0, 0, 639, 7);
+
+    // Every covered pixel stays covered
+    s = make({{3, 3, 100, 9}, {50, 70, 51, 200}, {200, 5, 319, 6}, {0, 239, 319, 239}});
+    const Areas in = s;
+    s.coalesce_tiles(24, 10, 320, 240);
+    for (uint32_t i = 0; i < in.count; ++i) {
+        const lv_area_t& a = in.areas[i];
+        CHECK(covered(s, a.x1, a.y1) && covered(s, a.x2, a.y2) && covered(s, a.x1, a.y2) && covered(s, a.x2, a.y1));
+    }
+}
+
+static void test_merge_overhead() {
+    // Side by side: the join adds nothing
+    Areas s = make({{0, 0, 9, 9}, {10, 0, 19, 9}});
+    s.merge_by_overhead(0);
+    CHECK(s.count == 1);
+    CHECK_AREA(s.areas[0], 0, 0, 19, 9);
+
+    // Diagonal 10 x 10 squares: the join is 400 px for 200, +100 %
+    s = make({{0, 0, 9, 9}, {10, 10, 19, 19}});
+    s.merge_by_overhead(99);
+    CHECK(s.count == 2);
+    s.merge_by_overhead(100);
+    CHECK(s.count == 1);
+}
+
+static void test_cap_rects() {
+    // The two close areas join first
+    Areas s = make({{0, 0, 9, 9}, {12, 0, 21, 9}, {200, 200, 209, 209}});
+    s.cap_rects(2);
+    CHECK(s.count == 2);
+    CHECK_AREA(s.areas[0], 0, 0, 21, 9);
+    CHECK_AREA(s.areas[1], 200, 200, 209, 209);
+    s.cap_rects(1);
+    CHECK(s.count == 1);
+    CHECK_AREA(s.areas[0], 0, 0, 209, 209);
+}
+
+static void test_push_full() {
+    // Beyond capacity, an area joins the one where that costs least
+    Areas s;
+    for (int32_t i = 0; i < 8; ++i) s.push({i * 100, 0, i * 100 + 9, 9});
+    s.push({305, 0, 314, 9});
+    CHECK(s.count == 8);
+    CHECK_AREA(s.areas[3], 300, 0, 314, 9);
+    CHECK(s.pixels() == 8 * 100 + 50);
+}
+
+int main() {
+    test_tiles_snap();
+    test_tiles_runs();
+    test_tiles_edges();
+    test_merge_overhead();
+    test_cap_rects();
+    test_push_full();
+    return lv_test::result();
+}
@@ -0,0 +1,68 @@
+/**
+ * @file touch_resampler_test.cpp
+ * @brief Interpolation and extrapolation of timestamped touch samples
+ */
+
+#include <lv/core/touch_resampler.hpp>
+#include "check.hpp"
+
+using History = lv::detail::TouchHistory<8>;
+
+// Finger moving right and down: 10 ms apart, 100 px and 0/50 px per step
+static History stroke() {
+    History h;
+    h.add(100, {0, 0});
+    h.add(110, {100, 0});
+    h.add(120, {200, 50});
+    return h;
+}
+
+static void test_interpolate() {
+    const History h = stroke();
+    const lv::ResampleConfig cfg{.latency_ms = 5, .predict_ms = 0};
+    CHECK_POINT(h.resample(120, cfg), 150, 25);   // t = 115
+    CHECK_POINT(h.resample(123, cfg), 180, 40);   // t = 118
+    CHECK_POINT(h.resample(110, cfg), 50, 0);     // t = 105
+    CHECK_POINT(h.resample(125, cfg), 200, 50);   // t = 120: newest
+}
+
+static void test_extrapolate() {
+    const History h = stroke();
+    lv::ResampleConfig cfg{.latency_ms = 0, .predict_ms = 4};
+    CHECK_POINT(h.resample(120, cfg), 240, 70);   // 4 ms ahead
+    cfg.predict_ms = 8;
+    CHECK_POINT(h.resample(122, cfg), 280, 90);   // 10 ms ahead, bounded to 8
+}
+
+static void test_limits() {
+    History h = stroke();
+    // Target before the oldest sample
+    CHECK_POINT(h.resample(120, {.latency_ms = 50}), 0, 0);
+    // No new sample for longer than max_gap_ms: the finger rests
+    CHECK_POINT(h.resample(200, {.latency_ms = 0, .predict_ms = 8}), 200, 50);
+    // Samples too far apart are not interpolated
+    h.add(160, {400, 50});
+    CHECK_POINT(h.resample(160, {.latency_ms = 20, .max_gap_ms = 32}), 400, 50);
+    // Same time stamp replaces the newest sample
+    h.add(160, {410, 60});
+    CHECK(h.size() == 4);
+    CHECK_POINT(h.resample(160, {.latency_ms = 0}), 410, 60);
+}
+
+static void test_ring() {
+    History h;
+    for (uint32_t i = 0; i < 20; ++i) h.add(i * 10, {static_cast<int32_t>(i * 10), 0});
+    CHECK(h.size() == 8);
+    CHECK_POINT(h.resample(190, {.latency_ms = 15}), 175, 0);
+    CHECK_POINT(h.resample(190, {.latency_ms = 200}), 120, 0);   // Oldest kept
+    h.clear();
+    CHECK(h.size() == 0);
+}
+
+int main() {
+    test_interpolate();
+    test_extrapolate();
+    test_limits();
+    test_ring();
+    return lv_test::result();
+}
@@ -0,0 +1,118 @@
+/**
+ * @file vector_scene_test.cpp
+ * @brief Merging of VectorScene's node changes into a few dirty areas, and their refresh
+ */
+
+#include <lv/draw/draw_vector.hpp>
+#include "check.hpp"
+
+#define CHECK_AREA(a, ax1, ay1, ax2, ay2) \
+    CHECK((a).x1 == (ax1) && (a).y1 == (ay1) && (a).x2 == (ax2) && (a).y2 == (ay2))
+
+using lv::detail::merge_dirty;
+
+static void test_overlap() {
+    lv_area_t areas[4];
+    uint32_t n = 0;
+    merge_dirty(areas, n, 4, {0, 0, 9, 9});
+    merge_dirty(areas, n, 4, {5, 5, 14, 14});   // Overlaps: joined
+    CHECK(n == 1);
+    CHECK_AREA(areas[0], 0, 0, 14, 14);
+
+    merge_dirty(areas, n, 4, {14, 0, 20, 2});   // Shares column 14
+    CHECK(n == 1);
+    CHECK_AREA(areas[0], 0, 0, 20, 14);
+
+    merge_dirty(areas, n, 4, {2, 2, 3, 3});     // Inside: unchanged
+    CHECK(n == 1);
+    CHECK_AREA(areas[0], 0, 0, 20, 14);
+}
+
+static void test_separate() {
+    lv_area_t areas[4];
+    uint32_t n = 0;
+    merge_dirty(areas, n, 4, {0, 0, 9, 9});
+    merge_dirty(areas, n, 4, {10, 0, 19, 9});   // Adjacent, not overlapping
+    merge_dirty(areas, n, 4, {100, 100, 109, 109});
+    CHECK(n == 3);
+    CHECK_AREA(areas[0], 0, 0, 9, 9);
+    CHECK_AREA(areas[1], 10, 0, 19, 9);
+    CHECK_AREA(areas[2], 100, 100, 109, 109);
+}
+
+static void test_full() {
+    lv_area_t areas[4];
+    uint32_t n = 0;
+    merge_dirty(areas, n, 4, {0, 0, 9, 9});
+    merge_dirty(areas, n, 4, {100, 0, 109, 9});
+    merge_dirty(areas, n, 4, {0, 100, 9, 109});
+    merge_dirty(areas, n, 4, {200, 200, 299, 299});
+    CHECK(n == 4);
+
+    // Full: joined into the area that grows least (the big one grows by 10 x 100)
+    merge_dirty(areas, n, 4, {300, 200, 309, 299});
+    CHECK(n == 4);
+    CHECK_AREA(areas[3], 200, 200, 309, 299);
+    CHECK_AREA(areas[0], 0, 0, 9, 9);
+
+    // Near the first small one: that grows least
+    merge_dirty(areas, n, 4, {12, 0, 21, 9});
+    CHECK(n == 4);
+    CHECK_AREA(areas[0], 0, 0, 21, 9);
+    CHECK_AREA(areas[1], 100, 0, 109, 9);
+}
+
+static uint32_t g_flushes = 0;
+
+static void count_flush(lv_display_t* disp, const lv_area_t*, uint8_t*) {
+    ++g_flushes;
+    lv_display_flush_ready(disp);
+}
+
+/// Run LVGL for a number of refresh periods
+static void run(uint32_t periods) {
+    for (uint32_t i = 0; i < periods; ++i) {
+        lv_tick_inc(LV_DEF_REFR_PERIOD);
+        lv_timer_handler();
+    }
+}
+
+static void test_idle_display() {
+    alignas(LV_DRAW_BUF_ALIGN) static uint8_t buf[64 * 64 * 4];
+    lv_display_t* disp = lv_display_create(64, 64);
+    lv_display_set_buffers(disp, buf, nullptr, sizeof(buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, &count_flush);
+    lv_obj_t* obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 64, 64);
+    {
+        lv::VectorScene scene(obj, 4);
+        auto node = scene.add(lv::VectorPath().rect(0, 0, 8, 8));
+        run(5);
+
+        // Nothing changes: the display goes idle and its refresh timer pauses
+        g_flushes = 0;
+        run(5);
+        CHECK(g_flushes == 0);
+
+        // A node change alone must bring the refresh back
+        lv_matrix_t m;
+        lv_matrix_identity(&m);
+        lv_matrix_translate(&m, 20, 20);
+        node.transform(m);
+        run(2);
+        CHECK(g_flushes > 0);
+        CHECK(scene.stats().invalidations > 0);
+    }
+    lv_display_delete(disp);
+}
+
+int main() {
+    test_overlap();
+    test_separate();
+    test_full();
+
+    lv_init();
+    test_idle_display();
+    lv_deinit();
+    return lv_test::result();
+}